@@ -3,15 +3,44 @@
 #include <string.h>  // Manipulation de chaînes (strlen, strcpy, strcspn)
 #include <ctype.h>   // Vérification/conversion de caractères (isalpha, isupper, toupper)
 #include <math.h>    // Fonctions mathématiques (log2)
+#include <stdint.h>  // Types entiers de taille fixe (uint8_t, uint16_t)
+#include <errno.h>   // Codes d'erreur (EINTR)
+#include <unistd.h>  // Entrées/sorties sur descripteurs (read, write)
+#include <fcntl.h>   // Ouverture de fichiers (open)
+#include <sys/mman.h> // Projection de fichiers en mémoire (mmap)
+#include <sys/stat.h> // Taille des fichiers (fstat)
+#include <thread>    // Threads (recherches exhaustives parallèles)
+#include <atomic>    // Compteurs partagés entre threads
+#include <vector>    // Threads lancés par run_workers
+#include <exception> // Échec de création d'un thread (std::system_error)
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h> // Intrinsèques SSSE3 / AVX2 (pshufb)
+#define CRYPTO_HAVE_X86_SIMD 1
+#else
+#define CRYPTO_HAVE_X86_SIMD 0
+#endif
 
 // --- Définitions globales ---
 #define ALPHABET_SIZE 26 // Taille de l'alphabet (A-Z)
+#define STREAM_BUFFER_SIZE 65536 // Taille du tampon des fonctions de chiffrement en flux
+#define BATCH_CHUNK 256 // Messages distribués à la fois à un thread par le traitement par lots
 
 // Structure pour une matrice 2x2, utilisée par le chiffrement de Hill
 typedef struct {
     int mat[2][2];
 } Matrix2x2;
 
+// Taille maximale des clés du chiffrement de Hill généralisé
+#define HILL_MAX_N 8
+
+// Structure pour une matrice NxN (2 <= n <= HILL_MAX_N), utilisée par le
+// chiffrement de Hill généralisé. Seul le coin n x n de 'mat' est significatif.
+typedef struct {
+    int n;
+    int mat[HILL_MAX_N][HILL_MAX_N];
+} HillMatrix;
+
 // --- Fonctions Utilitaires Générales ---
 
 /**
@@ -32,60 +61,263 @@ int modInverse(int a, int m) {
 }
 
 /**
- * @brief Calcule les fréquences de chaque lettre alphabétique dans un texte.
- * @param text La chaîne à analyser.
- * @param frequencies Tableau de ALPHABET_SIZE doubles pour stocker les fréquences.
- * @return Le nombre total de caractères alphabétiques traités.
+ * @brief Choisit le nombre de threads pour 'work_items' tâches indépendantes.
+ * @return Le nombre de cœurs disponibles, borné par le nombre de tâches (au moins 1).
  */
-int calculate_frequencies(const char* text, double frequencies[ALPHABET_SIZE]) {
-    for (int i = 0; i < ALPHABET_SIZE; i++) {
-        frequencies[i] = 0.0;
+static unsigned worker_count(size_t work_items) {
+    unsigned thread_count = std::thread::hardware_concurrency();
+    if (thread_count == 0) thread_count = 1;
+    if (thread_count > work_items) thread_count = work_items > 0 ? (unsigned)work_items : 1;
+    return thread_count;
+}
+
+/**
+ * @brief Exécute worker(0) ... worker(thread_count - 1) en parallèle.
+ * Le thread appelant exécute worker(0). Si un thread ne peut être créé
+ * (std::system_error), les indices restants sont exécutés par le thread
+ * appelant : chaque indice est exécuté exactement une fois et les threads déjà
+ * lancés sont toujours attendus. Les workers se partageant le travail par
+ * compteur atomique, un worker exécuté en retard trouve simplement moins de tâches.
+ */
+template <typename F>
+static void run_workers(unsigned thread_count, F worker) {
+    std::vector<std::thread> threads;
+    unsigned started = 1;
+    try {
+        threads.reserve(thread_count - 1);
+        for (; started < thread_count; started++) {
+            threads.emplace_back(worker, started);
+        }
+    } catch (const std::exception&) {
+        // Plus de threads (ou de mémoire) disponibles : le thread appelant fait le reste
+    }
+    worker(0u);
+    for (unsigned t = started; t < thread_count; t++) {
+        worker(t);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
     }
+}
 
-    int total_alpha_chars = 0;
-    size_t len = strlen(text);
+// --- Profil statistique d'un texte ---
 
-    for (size_t i = 0; i < len; i++) {
-        char c = toupper(text[i]); // Convertit en majuscule pour un traitement unifié
-        if (c >= 'A' && c <= 'Z') {
-            frequencies[c - 'A']++;
-            total_alpha_chars++;
-        }
+// Profil d'un texte : comptes bruts de chaque lettre (casse ignorée) et
+// nombre total de lettres. Il est rempli en une seule passe ; fréquences,
+// entropie, redondance et IC en sont dérivés à la demande sans relire le texte.
+typedef struct {
+    size_t counts[ALPHABET_SIZE];
+    size_t total;
+} TextProfile;
+
+// Histogramme à tables entrelacées : des lettres répétées incrémentent des
+// tables différentes, ce qui évite d'enchaîner lecture/écriture sur le même
+// compteur. L'entrée ALPHABET_SIZE de chaque table recueille les non-lettres.
+#define HISTOGRAM_TABLES 4
+typedef uint64_t letter_histogram_tables[HISTOGRAM_TABLES][ALPHABET_SIZE + 1];
+
+// Signature commune des noyaux d'histogramme (les tables sont cumulées, pas remises à zéro).
+typedef void (*histogram_kernel_fn)(const char* text, size_t len, letter_histogram_tables tables);
+
+/**
+ * @brief Ramène un octet sur 0..25 pour une lettre (casse ignorée), ALPHABET_SIZE sinon.
+ */
+static inline unsigned histogram_bucket(unsigned char c) {
+    unsigned letter = (unsigned)((c | 0x20) - 'a');
+    return letter < ALPHABET_SIZE ? letter : ALPHABET_SIZE;
+}
+
+/**
+ * @brief Noyau scalaire : répartit les incréments sur les tables entrelacées.
+ */
+static void histogram_kernel_scalar(const char* text, size_t len, letter_histogram_tables tables) {
+    size_t i = 0;
+    for (; i + HISTOGRAM_TABLES <= len; i += HISTOGRAM_TABLES) {
+        tables[0][histogram_bucket((unsigned char)text[i])]++;
+        tables[1][histogram_bucket((unsigned char)text[i + 1])]++;
+        tables[2][histogram_bucket((unsigned char)text[i + 2])]++;
+        tables[3][histogram_bucket((unsigned char)text[i + 3])]++;
+    }
+    for (; i < len; i++) {
+        tables[0][histogram_bucket((unsigned char)text[i])]++;
     }
+}
 
-    if (total_alpha_chars > 0) {
-        for (int i = 0; i < ALPHABET_SIZE; i++) {
-            frequencies[i] /= total_alpha_chars;
-        }
+#if CRYPTO_HAVE_X86_SIMD && defined(__x86_64__) // _mm256_extract_epi64 exige le mode 64 bits
+/**
+ * @brief Ajoute aux tables entrelacées les 8 indices d'un mot de 64 bits.
+ */
+static inline void histogram_add_word(letter_histogram_tables tables, uint64_t word) {
+    tables[0][word & 0xFF]++;
+    tables[1][(word >> 8) & 0xFF]++;
+    tables[2][(word >> 16) & 0xFF]++;
+    tables[3][(word >> 24) & 0xFF]++;
+    tables[0][(word >> 32) & 0xFF]++;
+    tables[1][(word >> 40) & 0xFF]++;
+    tables[2][(word >> 48) & 0xFF]++;
+    tables[3][word >> 56]++;
+}
+
+/**
+ * @brief Noyau AVX2 : replie la casse et calcule l'indice de 32 octets à la fois.
+ * (x | 0x20) - 'a' vaut 0..25 exactement pour les lettres ; un minimum non
+ * signé avec 26 envoie tout le reste dans l'entrée des non-lettres. Les
+ * indices sont extraits par mots de 64 bits (sans repasser par la mémoire)
+ * puis dispersés sur les tables entrelacées.
+ */
+__attribute__((target("avx2")))
+static void histogram_kernel_avx2(const char* text, size_t len, letter_histogram_tables tables) {
+    const __m256i case_bit = _mm256_set1_epi8(0x20);
+    const __m256i base = _mm256_set1_epi8('a');
+    const __m256i sentinel = _mm256_set1_epi8(ALPHABET_SIZE);
+
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(text + i));
+        __m256i letter = _mm256_sub_epi8(_mm256_or_si256(x, case_bit), base);
+        __m256i idx = _mm256_min_epu8(letter, sentinel);
+        histogram_add_word(tables, (uint64_t)_mm256_extract_epi64(idx, 0));
+        histogram_add_word(tables, (uint64_t)_mm256_extract_epi64(idx, 1));
+        histogram_add_word(tables, (uint64_t)_mm256_extract_epi64(idx, 2));
+        histogram_add_word(tables, (uint64_t)_mm256_extract_epi64(idx, 3));
     }
-    return total_alpha_chars;
+    histogram_kernel_scalar(text + i, len - i, tables);
 }
+#endif
 
-// --- 2. Entropie, Redondance et Indice de Coïncidence ---
+/**
+ * @brief Choisit le noyau d'histogramme le plus rapide supporté par le processeur.
+ */
+static histogram_kernel_fn select_histogram_kernel() {
+#if CRYPTO_HAVE_X86_SIMD && defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return histogram_kernel_avx2;
+#endif
+    return histogram_kernel_scalar;
+}
+
+// Noyau sélectionné une seule fois au démarrage du programme.
+static const histogram_kernel_fn histogram_kernel = select_histogram_kernel();
 
 /**
- * @brief Calcule l'entropie d'un texte.
- * Mesure la quantité d'information ou d'incertitude.
- * @param text Le texte à analyser.
- * @return L'entropie en bits par caractère.
+ * @brief Compte les lettres d'un texte (casse ignorée) avec le noyau d'histogramme.
+ * @param text Le texte à analyser (octets nuls autorisés).
+ * @param len Le nombre d'octets du texte.
+ * @param counts Reçoit le nombre d'occurrences de chaque lettre.
  */
-double calculate_entropy(const char* text) {
-    double frequencies[ALPHABET_SIZE];
-    int total_alpha_chars = calculate_frequencies(text, frequencies);
+void letter_histogram(const char* text, size_t len, size_t counts[ALPHABET_SIZE]) {
+    letter_histogram_tables tables = {{0}};
+    histogram_kernel(text, len, tables);
+    // Fusionne les tables entrelacées
+    for (int l = 0; l < ALPHABET_SIZE; l++) {
+        counts[l] = (size_t)(tables[0][l] + tables[1][l] + tables[2][l] + tables[3][l]);
+    }
+}
+
+/**
+ * @brief Remplit le profil d'un texte en une seule passe.
+ * @param text Le texte à analyser (octets nuls autorisés).
+ * @param len Le nombre d'octets du texte.
+ * @param profile Le profil à remplir.
+ */
+void build_text_profile(const char* text, size_t len, TextProfile* profile) {
+    letter_histogram(text, len, profile->counts);
+    profile->total = 0;
+    for (int i = 0; i < ALPHABET_SIZE; i++) {
+        profile->total += profile->counts[i];
+    }
+}
 
-    if (total_alpha_chars == 0) {
+/**
+ * @brief Calcule les fréquences normalisées des lettres d'un profil.
+ * @param profile Le profil du texte.
+ * @param frequencies Tableau de ALPHABET_SIZE doubles pour stocker les fréquences.
+ */
+void profile_frequencies(const TextProfile* profile, double frequencies[ALPHABET_SIZE]) {
+    for (int i = 0; i < ALPHABET_SIZE; i++) {
+        frequencies[i] = profile->total > 0 ? (double)profile->counts[i] / profile->total : 0.0;
+    }
+}
+
+/**
+ * @brief Calcule l'entropie d'un profil (26 logarithmes au plus, quelle que soit la longueur du texte).
+ * @param profile Le profil du texte.
+ * @return L'entropie en bits par caractère.
+ */
+double profile_entropy(const TextProfile* profile) {
+    if (profile->total == 0) {
         return 0.0;
     }
 
     double entropy = 0.0;
     for (int i = 0; i < ALPHABET_SIZE; i++) {
-        if (frequencies[i] > 0) {
-            entropy -= frequencies[i] * log2(frequencies[i]);
+        if (profile->counts[i] > 0) {
+            double f = (double)profile->counts[i] / profile->total;
+            entropy -= f * log2(f);
         }
     }
     return entropy;
 }
 
+/**
+ * @brief Calcule la redondance d'un profil.
+ * @param profile Le profil du texte.
+ * @return La redondance en bits par caractère.
+ */
+double profile_redundancy(const TextProfile* profile) {
+    double H_max = log2(ALPHABET_SIZE); // Entropie maximale théorique
+    return H_max - profile_entropy(profile);
+}
+
+/**
+ * @brief Calcule l'incidence de coïncidence (IC) d'un profil.
+ * @param profile Le profil du texte.
+ * @return La valeur de l'incidence de coïncidence.
+ */
+double profile_ic(const TextProfile* profile) {
+    if (profile->total < 2) {
+        return 0.0;
+    }
+
+    double ic = 0.0;
+    for (int i = 0; i < ALPHABET_SIZE; i++) {
+        ic += (double)profile->counts[i] * ((double)profile->counts[i] - 1);
+    }
+    ic /= ((double)profile->total * ((double)profile->total - 1));
+
+    return ic;
+}
+
+/**
+ * @brief Calcule les fréquences de chaque lettre alphabétique dans un texte.
+ * @param text La chaîne à analyser.
+ * @param frequencies Tableau de ALPHABET_SIZE doubles pour stocker les fréquences.
+ * @return Le nombre total de caractères alphabétiques traités.
+ */
+int calculate_frequencies(const char* text, double frequencies[ALPHABET_SIZE]) {
+    TextProfile profile;
+    build_text_profile(text, strlen(text), &profile);
+    profile_frequencies(&profile, frequencies);
+    return (int)profile.total;
+}
+
+// --- 2. Entropie, Redondance et Indice de Coïncidence ---
+// Ces fonctions construisent chacune un profil ; pour calculer plusieurs
+// mesures sur un même texte, construire le profil une fois et utiliser
+// directement les fonctions profile_*.
+
+/**
+ * @brief Calcule l'entropie d'un texte.
+ * Mesure la quantité d'information ou d'incertitude.
+ * @param text Le texte à analyser.
+ * @return L'entropie en bits par caractère.
+ */
+double calculate_entropy(const char* text) {
+    TextProfile profile;
+    build_text_profile(text, strlen(text), &profile);
+    return profile_entropy(&profile);
+}
+
 /**
  * @brief Calcule la redondance d'un texte.
  * Mesure l'excès d'information ou la prévisibilité.
@@ -93,9 +325,9 @@ double calculate_entropy(const char* text) {
  * @return La redondance en bits par caractère.
  */
 double calculate_redundancy(const char* text) {
-    double H = calculate_entropy(text);
-    double H_max = log2(ALPHABET_SIZE); // Entropie maximale théorique
-    return H_max - H;
+    TextProfile profile;
+    build_text_profile(text, strlen(text), &profile);
+    return profile_redundancy(&profile);
 }
 
 /**
@@ -105,32 +337,132 @@ double calculate_redundancy(const char* text) {
  * @return La valeur de l'incidence de coïncidence.
  */
 double calculate_ic(const char* text) {
-    int counts[ALPHABET_SIZE] = {0};
-    int total_alpha_chars = 0;
-    size_t len = strlen(text);
+    TextProfile profile;
+    build_text_profile(text, strlen(text), &profile);
+    return profile_ic(&profile);
+}
 
-    for (size_t i = 0; i < len; i++) {
-        char c = toupper(text[i]);
-        if (c >= 'A' && c <= 'Z') {
-            counts[c - 'A']++;
-            total_alpha_chars++;
+// --- 2.1 Le chiffrement de Lester Hill (matrice 2x2) ---
+
+/**
+ * @brief Calcule le déterminant d'une clé de Hill 2x2 ramené entre 0 et 25.
+ * @param key La matrice clé.
+ * @return Le déterminant modulo 26.
+ */
+static int hill_determinant(Matrix2x2 key) {
+    int det = (key.mat[0][0] * key.mat[1][1] - key.mat[0][1] * key.mat[1][0]) % ALPHABET_SIZE;
+    if (det < 0) det += ALPHABET_SIZE;
+    return det;
+}
+
+// Nombre de digrammes possibles (26 x 26)
+#define DIGRAM_COUNT (ALPHABET_SIZE * ALPHABET_SIZE)
+
+// Clé de Hill 2x2 compilée : pour une clé fixe, le chiffrement est une
+// permutation des 676 digrammes. Chaque entrée, indexée par p1 * 26 + p2,
+// contient les deux lettres de sortie déjà converties en ASCII (première
+// lettre dans l'octet bas, seconde dans l'octet haut).
+typedef struct {
+    uint16_t enc[DIGRAM_COUNT]; // Digramme clair -> digramme chiffré
+    uint16_t dec[DIGRAM_COUNT]; // Digramme chiffré -> digramme clair
+} HillDigramTable;
+
+/**
+ * @brief Précalcule les tables de digrammes d'une clé de Hill 2x2.
+ * @param key La matrice clé 2x2.
+ * @param table La table à remplir.
+ * @return 0 en cas de succès, -1 si la clé n'est pas inversible modulo 26.
+ */
+int compile_hill_table(Matrix2x2 key, HillDigramTable* table) {
+    if (modInverse(hill_determinant(key), ALPHABET_SIZE) == -1) {
+        return -1;
+    }
+
+    int k[2][2];
+    for (int r = 0; r < 2; r++) {
+        for (int c = 0; c < 2; c++) {
+            k[r][c] = key.mat[r][c] % ALPHABET_SIZE;
+            if (k[r][c] < 0) k[r][c] += ALPHABET_SIZE;
         }
     }
 
-    if (total_alpha_chars < 2) {
-        return 0.0;
+    for (int p1 = 0; p1 < ALPHABET_SIZE; p1++) {
+        for (int p2 = 0; p2 < ALPHABET_SIZE; p2++) {
+            int c1 = (k[0][0] * p1 + k[0][1] * p2) % ALPHABET_SIZE;
+            int c2 = (k[1][0] * p1 + k[1][1] * p2) % ALPHABET_SIZE;
+            table->enc[p1 * ALPHABET_SIZE + p2] = (uint16_t)(('A' + c1) | (('A' + c2) << 8));
+            // La clé étant inversible, l'inverse s'obtient en retournant la permutation.
+            table->dec[c1 * ALPHABET_SIZE + c2] = (uint16_t)(('A' + p1) | (('A' + p2) << 8));
+        }
     }
+    return 0;
+}
 
-    double ic = 0.0;
-    for (int i = 0; i < ALPHABET_SIZE; i++) {
-        ic += (double)counts[i] * (counts[i] - 1);
+/**
+ * @brief Chiffre un texte avec une clé de Hill compilée dans un tampon fourni.
+ *
+ * Filtre les lettres, les met en majuscules, les chiffre par paires et complète
+ * avec 'X' en une seule passe, sans allocation intermédiaire. Chaque paire coûte
+ * une consultation de la table de digrammes. Aucun terminateur n'est écrit.
+ *
+ * @param plaintext Le texte clair (octets nuls autorisés).
+ * @param len Le nombre d'octets du texte clair.
+ * @param table La clé compilée par compile_hill_table().
+ * @param out Le tampon de sortie (au moins len + 1 octets).
+ * @return Le nombre de lettres chiffrées écrites (toujours pair).
+ */
+size_t encrypt_hill(const char* plaintext, size_t len, const HillDigramTable* table, char* out) {
+    size_t written = 0;
+    int pending = -1; // Première lettre de la paire en cours, -1 si aucune
+    for (size_t i = 0; i < len; i++) {
+        int p = (unsigned char)plaintext[i];
+        if (p >= 'a' && p <= 'z') {
+            p -= 'a';
+        } else if (p >= 'A' && p <= 'Z') {
+            p -= 'A';
+        } else {
+            continue; // Les non-alphabétiques sont retirés
+        }
+
+        if (pending < 0) {
+            pending = p;
+            continue;
+        }
+        // Chiffre le bloc de 2 dès qu'il est complet
+        uint16_t digram = table->enc[pending * ALPHABET_SIZE + p];
+        out[written++] = (char)(digram & 0xFF);
+        out[written++] = (char)(digram >> 8);
+        pending = -1;
     }
-    ic /= ((double)total_alpha_chars * (total_alpha_chars - 1));
 
-    return ic;
+    // Gère le padding (complément) avec 'X'
+    if (pending >= 0) {
+        uint16_t digram = table->enc[pending * ALPHABET_SIZE + ('X' - 'A')];
+        out[written++] = (char)(digram & 0xFF);
+        out[written++] = (char)(digram >> 8);
+    }
+    return written;
 }
 
-// --- 2.1 Le chiffrement de Lester Hill (matrice 2x2) ---
+/**
+ * @brief Chiffre un texte avec le chiffrement de Hill (matrice 2x2) dans un tampon fourni.
+ * @param plaintext Le texte clair (octets nuls autorisés).
+ * @param len Le nombre d'octets du texte clair.
+ * @param key La matrice clé 2x2.
+ * @param out Le tampon de sortie (au moins len + 1 octets).
+ * @param out_len Reçoit le nombre de lettres chiffrées écrites (toujours pair).
+ * @return 0 en cas de succès, -1 si la clé n'est pas inversible.
+ */
+int encrypt_hill(const char* plaintext, size_t len, Matrix2x2 key, char* out, size_t* out_len) {
+    // Vérifie si la clé est inversible modulo 26
+    HillDigramTable table;
+    if (compile_hill_table(key, &table) == -1) {
+        fprintf(stderr, "Erreur Hill: Déterminant de la clé (%d) non inversible modulo %d.\n", hill_determinant(key), ALPHABET_SIZE);
+        return -1;
+    }
+    *out_len = encrypt_hill(plaintext, len, &table, out);
+    return 0;
+}
 
 /**
  * @brief Chiffre un texte avec le chiffrement de Hill (matrice 2x2).
@@ -140,51 +472,49 @@ double calculate_ic(const char* text) {
  * @return Le texte chiffré alloué dynamiquement, ou NULL en cas d'erreur (clé non inversible).
  */
 char* encrypt_hill(const char* plaintext, Matrix2x2 key) {
-    int alpha_count = 0;
-    for(size_t i = 0; i < strlen(plaintext); i++) {
-        if (isalpha(plaintext[i])) alpha_count++;
-    }
-
-    // Gère le padding (complément)
-    int padded_len = alpha_count;
-    if (padded_len % 2 != 0) padded_len++;
+    size_t len = strlen(plaintext);
 
-    char* processed_plaintext = (char*)malloc((padded_len + 1) * sizeof(char));
-    if (processed_plaintext == NULL) { perror("Échec d'allocation mémoire"); return NULL; }
-    int current_char_idx = 0;
-    for(size_t i = 0; i < strlen(plaintext); i++) {
-        if (isalpha(plaintext[i])) processed_plaintext[current_char_idx++] = toupper(plaintext[i]);
-    }
-    if (current_char_idx < padded_len) processed_plaintext[current_char_idx++] = 'X';
-    processed_plaintext[padded_len] = '\0';
+    // Une seule allocation : au plus len lettres, +1 pour le padding, +1 pour '\0'
+    char* ciphertext = (char*)malloc((len + 2) * sizeof(char));
+    if (ciphertext == NULL) { perror("Échec d'allocation mémoire"); return NULL; }
 
-    // Vérifie si la clé est inversible modulo 26
-    int det = (key.mat[0][0] * key.mat[1][1] - key.mat[0][1] * key.mat[1][0]) % ALPHABET_SIZE;
-    if (det < 0) det += ALPHABET_SIZE;
-    if (det == 0 || (det % 2 == 0) || (det % 13 == 0)) {
-        fprintf(stderr, "Erreur Hill: Déterminant de la clé (%d) non inversible modulo %d.\n", det, ALPHABET_SIZE);
-        free(processed_plaintext);
+    size_t cipher_len;
+    if (encrypt_hill(plaintext, len, key, ciphertext, &cipher_len) == -1) {
+        free(ciphertext);
         return NULL;
     }
+    ciphertext[cipher_len] = '\0';
+    return ciphertext;
+}
 
-    char* ciphertext = (char*)malloc((padded_len + 1) * sizeof(char));
-    if (ciphertext == NULL) { perror("Échec d'allocation mémoire"); free(processed_plaintext); return NULL; }
-
-    // Chiffre par blocs de 2
-    for (int i = 0; i < padded_len; i += 2) {
-        int p1 = processed_plaintext[i] - 'A';
-        int p2 = processed_plaintext[i+1] - 'A';
-
-        int c1 = (key.mat[0][0] * p1 + key.mat[0][1] * p2) % ALPHABET_SIZE;
-        int c2 = (key.mat[1][0] * p1 + key.mat[1][1] * p2) % ALPHABET_SIZE;
-
-        ciphertext[i] = c1 + 'A';
-        ciphertext[i+1] = c2 + 'A';
+/**
+ * @brief Déchiffre un texte avec une clé de Hill compilée dans un tampon fourni.
+ * Aucun terminateur n'est écrit.
+ * @param ciphertext Le texte chiffré (lettres majuscules uniquement).
+ * @param len Le nombre de lettres du texte chiffré (doit être pair).
+ * @param table La clé compilée par compile_hill_table().
+ * @param out Le tampon de sortie (au moins len octets).
+ * @return 0 en cas de succès, -1 si la longueur est impaire ou si un caractère n'est pas une majuscule.
+ */
+int decrypt_hill(const char* ciphertext, size_t len, const HillDigramTable* table, char* out) {
+    if (len % 2 != 0) {
+        fprintf(stderr, "Erreur Hill: Longueur du texte chiffré impaire.\n");
+        return -1;
     }
-    ciphertext[padded_len] = '\0';
 
-    free(processed_plaintext);
-    return ciphertext;
+    // Déchiffre par blocs de 2
+    for (size_t i = 0; i < len; i += 2) {
+        unsigned c1 = (unsigned char)ciphertext[i] - 'A';
+        unsigned c2 = (unsigned char)ciphertext[i+1] - 'A';
+        if (c1 >= ALPHABET_SIZE || c2 >= ALPHABET_SIZE) {
+            fprintf(stderr, "Erreur Hill: Caractère non alphabétique dans le texte chiffré.\n");
+            return -1;
+        }
+        uint16_t digram = table->dec[c1 * ALPHABET_SIZE + c2];
+        out[i] = (char)(digram & 0xFF);
+        out[i+1] = (char)(digram >> 8);
+    }
+    return 0;
 }
 
 /**
@@ -200,150 +530,2071 @@ char* decrypt_hill(const char* ciphertext, Matrix2x2 key) {
         return NULL;
     }
 
-    // Calcule l'inverse de la matrice clé
-    int det = (key.mat[0][0] * key.mat[1][1] - key.mat[0][1] * key.mat[1][0]) % ALPHABET_SIZE;
-    if (det < 0) det += ALPHABET_SIZE;
-    
-    int det_inv = modInverse(det, ALPHABET_SIZE);
-    if (det_inv == -1) {
+    // Précalcule la table de digrammes inverse de la clé
+    HillDigramTable table;
+    if (compile_hill_table(key, &table) == -1) {
         fprintf(stderr, "Erreur Hill: Inverse du déterminant non trouvé.\n");
         return NULL;
     }
 
-    Matrix2x2 inv_key;
-    inv_key.mat[0][0] = (key.mat[1][1] * det_inv) % ALPHABET_SIZE;
-    inv_key.mat[0][1] = (-key.mat[0][1] * det_inv) % ALPHABET_SIZE;
-    inv_key.mat[1][0] = (-key.mat[1][0] * det_inv) % ALPHABET_SIZE;
-    inv_key.mat[1][1] = (key.mat[0][0] * det_inv) % ALPHABET_SIZE;
-
-    // Assure que les éléments de la matrice inverse sont positifs
-    for (int r = 0; r < 2; r++) {
-        for (int c = 0; c < 2; c++) {
-            if (inv_key.mat[r][c] < 0) {
-                inv_key.mat[r][c] += ALPHABET_SIZE;
-            }
-        }
-    }
-
     char* plaintext = (char*)malloc((cipher_len + 1) * sizeof(char));
     if (plaintext == NULL) { perror("Échec d'allocation mémoire"); return NULL; }
 
-    // Déchiffre par blocs de 2
-    for (size_t i = 0; i < cipher_len; i += 2) {
-        int c1 = ciphertext[i] - 'A';
-        int c2 = ciphertext[i+1] - 'A';
-
-        int p1 = (inv_key.mat[0][0] * c1 + inv_key.mat[0][1] * c2) % ALPHABET_SIZE;
-        int p2 = (inv_key.mat[1][0] * c1 + inv_key.mat[1][1] * c2) % ALPHABET_SIZE;
-
-        plaintext[i] = p1 + 'A';
-        plaintext[i+1] = p2 + 'A';
+    if (decrypt_hill(ciphertext, cipher_len, &table, plaintext) == -1) {
+        free(plaintext);
+        return NULL;
     }
     plaintext[cipher_len] = '\0';
 
     return plaintext;
 }
 
-// --- 2.2 Le chiffrement affine ---
+// --- 2.2 Le chiffrement de Hill généralisé (matrices NxN) ---
 
 /**
- * @brief Chiffre un texte clair avec le chiffrement affine.
- * @param plaintext Le texte clair.
- * @param a Clé multiplicative (doit être coprime avec 26).
- * @param b Clé additive.
- * @return Le texte chiffré alloué dynamiquement, ou NULL en cas d'erreur.
+ * @brief Inverse une matrice NxN modulo 26 par élimination de Gauss modulaire.
+ *
+ * 26 n'étant pas premier, une colonne peut ne contenir aucun pivot inversible
+ * alors que la matrice l'est (ex. 2 et 13). Les lignes candidates sont donc
+ * d'abord combinées à la manière de l'algorithme d'Euclide jusqu'à ce qu'il ne
+ * reste qu'un seul coefficient non nul, qui est inversible si et seulement si
+ * la matrice l'est.
+ *
+ * @param key La matrice à inverser.
+ * @param inverse Reçoit la matrice inverse.
+ * @return 0 en cas de succès, -1 si la matrice n'est pas inversible modulo 26.
  */
-char* encrypt_affine(const char* plaintext, int a, int b) {
-    // Vérifie que 'a' est inversible modulo 26
-    if (modInverse(a, ALPHABET_SIZE) == -1) {
-        fprintf(stderr, "Erreur Affine: Clé 'a' (%d) non inversible modulo %d.\n", a, ALPHABET_SIZE);
-        return NULL;
+int invert_hill_matrix(const HillMatrix* key, HillMatrix* inverse) {
+    int n = key->n;
+    if (n < 2 || n > HILL_MAX_N) {
+        return -1;
     }
 
-    size_t len = strlen(plaintext);
-    char* ciphertext = (char*)malloc((len + 1) * sizeof(char));
-    if (ciphertext == NULL) { perror("Échec d'allocation mémoire"); return NULL; }
+    // Matrice augmentée [key | I]
+    int aug[HILL_MAX_N][2 * HILL_MAX_N];
+    for (int r = 0; r < n; r++) {
+        for (int c = 0; c < n; c++) {
+            int v = key->mat[r][c] % ALPHABET_SIZE;
+            aug[r][c] = v < 0 ? v + ALPHABET_SIZE : v;
+            aug[r][n + c] = (r == c);
+        }
+    }
 
-    // Parcourt et chiffre chaque caractère alphabétique.
-    for (size_t i = 0; i < len; i++) {
-        char current_char = plaintext[i];
-        if (isalpha(current_char)) {
-            char base = isupper(current_char) ? 'A' : 'a';
-            int P = current_char - base;
-            
-            int C = (a * P + b) % ALPHABET_SIZE;
-            if (C < 0) C += ALPHABET_SIZE; // Assure un résultat positif
-
-            ciphertext[i] = C + base;
-        } else {
-            ciphertext[i] = current_char; // Non-alphabétiques inchangés
+    for (int col = 0; col < n; col++) {
+        // Réduction euclidienne de la colonne sur les lignes col..n-1
+        for (;;) {
+            int pivot_row = -1;
+            int nonzero = 0;
+            for (int r = col; r < n; r++) {
+                if (aug[r][col] != 0) {
+                    nonzero++;
+                    if (pivot_row < 0 || aug[r][col] < aug[pivot_row][col]) pivot_row = r;
+                }
+            }
+            if (pivot_row < 0) {
+                return -1; // Colonne nulle : matrice singulière
+            }
+            if (nonzero == 1) {
+                if (pivot_row != col) {
+                    for (int c = 0; c < 2 * n; c++) {
+                        int tmp = aug[col][c];
+                        aug[col][c] = aug[pivot_row][c];
+                        aug[pivot_row][c] = tmp;
+                    }
+                }
+                break;
+            }
+            // Remplace chaque autre coefficient par son reste modulo le plus petit
+            for (int r = col; r < n; r++) {
+                if (r == pivot_row || aug[r][col] == 0) continue;
+                int q = aug[r][col] / aug[pivot_row][col];
+                for (int c = 0; c < 2 * n; c++) {
+                    aug[r][c] = ((aug[r][c] - q * aug[pivot_row][c]) % ALPHABET_SIZE + ALPHABET_SIZE) % ALPHABET_SIZE;
+                }
+            }
+        }
+
+        // Normalise la ligne pivot puis élimine la colonne des autres lignes
+        int pivot_inv = modInverse(aug[col][col], ALPHABET_SIZE);
+        if (pivot_inv == -1) {
+            return -1;
+        }
+        for (int c = 0; c < 2 * n; c++) {
+            aug[col][c] = (aug[col][c] * pivot_inv) % ALPHABET_SIZE;
+        }
+        for (int r = 0; r < n; r++) {
+            if (r == col || aug[r][col] == 0) continue;
+            int factor = aug[r][col];
+            for (int c = 0; c < 2 * n; c++) {
+                aug[r][c] = ((aug[r][c] - factor * aug[col][c]) % ALPHABET_SIZE + ALPHABET_SIZE) % ALPHABET_SIZE;
+            }
         }
     }
-    ciphertext[len] = '\0';
-    return ciphertext;
+
+    inverse->n = n;
+    for (int r = 0; r < n; r++) {
+        for (int c = 0; c < n; c++) {
+            inverse->mat[r][c] = aug[r][n + c];
+        }
+    }
+    return 0;
 }
 
+// Clé de Hill NxN réduite modulo 26 et stockée de façon contiguë, pour que
+// le produit matrice-bloc de taille fixe se déroule et se vectorise.
+template <int N>
+struct HillKernelKey {
+    int mat[N][N];
+};
+
 /**
- * @brief Déchiffre un texte chiffré avec le chiffrement affine.
- * @param ciphertext Le texte chiffré.
- * @param a Clé multiplicative.
- * @param b Clé additive.
- * @return Le texte clair alloué dynamiquement, ou NULL en cas d'erreur.
+ * @brief Réduit une HillMatrix modulo 26 dans une clé de taille fixe N.
  */
-char* decrypt_affine(const char* ciphertext, int a, int b) {
-    int a_inv = modInverse(a, ALPHABET_SIZE);
-    if (a_inv == -1) {
-        fprintf(stderr, "Erreur Affine: Clé 'a' (%d) non inversible modulo %d.\n", a, ALPHABET_SIZE);
-        return NULL;
+template <int N>
+static HillKernelKey<N> make_hill_kernel_key(const HillMatrix* key) {
+    HillKernelKey<N> k;
+    for (int r = 0; r < N; r++) {
+        for (int c = 0; c < N; c++) {
+            int v = key->mat[r][c] % ALPHABET_SIZE;
+            k.mat[r][c] = v < 0 ? v + ALPHABET_SIZE : v;
+        }
     }
+    return k;
+}
 
-    size_t len = strlen(ciphertext);
-    char* plaintext = (char*)malloc((len + 1) * sizeof(char));
-    if (plaintext == NULL) { perror("Échec d'allocation mémoire"); return NULL; }
+/**
+ * @brief Multiplie un bloc de N lettres (0-25) par la clé et écrit N majuscules.
+ * N étant une constante de compilation, les deux boucles sont entièrement déroulées.
+ */
+template <int N>
+static inline void hill_multiply_block(const HillKernelKey<N>& key, const int block[N], char* out) {
+    for (int r = 0; r < N; r++) {
+        int acc = 0; // Au plus 8 * 25 * 25 : une seule réduction modulo 26 suffit
+        for (int c = 0; c < N; c++) {
+            acc += key.mat[r][c] * block[c];
+        }
+        out[r] = (char)(acc % ALPHABET_SIZE + 'A');
+    }
+}
 
-    // Parcourt et déchiffre chaque caractère alphabétique.
+/**
+ * @brief Chiffre en une passe : filtre, met en majuscules, chiffre par blocs de N
+ * et complète le dernier bloc avec 'X'.
+ * @return Le nombre de lettres écrites (multiple de N).
+ */
+template <int N>
+static size_t hill_encrypt_blocks(const HillMatrix* key, const char* in, size_t len, char* out) {
+    const HillKernelKey<N> k = make_hill_kernel_key<N>(key);
+    int block[N];
+    int filled = 0;
+    size_t written = 0;
     for (size_t i = 0; i < len; i++) {
-        char current_char = ciphertext[i];
-        if (isalpha(current_char)) {
-            char base = isupper(current_char) ? 'A' : 'a';
-            int C = current_char - base;
-
-            // Formule de déchiffrement: P = a_inv * (C - b) mod 26
-            int P = (a_inv * (C - b));
-            P = (P % ALPHABET_SIZE + ALPHABET_SIZE) % ALPHABET_SIZE; // Assure un résultat positif
-
-            plaintext[i] = P + base;
+        int p = (unsigned char)in[i];
+        if (p >= 'a' && p <= 'z') {
+            p -= 'a';
+        } else if (p >= 'A' && p <= 'Z') {
+            p -= 'A';
         } else {
-            plaintext[i] = current_char; // Non-alphabétiques inchangés
+            continue; // Les non-alphabétiques sont retirés
+        }
+        block[filled++] = p;
+        if (filled == N) {
+            hill_multiply_block<N>(k, block, out + written);
+            written += N;
+            filled = 0;
         }
     }
-    plaintext[len] = '\0';
-    return plaintext;
+    // Gère le padding (complément) avec 'X'
+    if (filled > 0) {
+        while (filled < N) block[filled++] = 'X' - 'A';
+        hill_multiply_block<N>(k, block, out + written);
+        written += N;
+    }
+    return written;
 }
 
+/**
+ * @brief Multiplie par la clé chaque bloc de N majuscules d'un texte de longueur multiple de N.
+ * @return 0 en cas de succès, -1 si un caractère n'est pas une majuscule.
+ */
+template <int N>
+static int hill_transform_blocks(const HillMatrix* key, const char* in, size_t len, char* out) {
+    const HillKernelKey<N> k = make_hill_kernel_key<N>(key);
+    int block[N];
+    for (size_t i = 0; i < len; i += N) {
+        for (int c = 0; c < N; c++) {
+            unsigned v = (unsigned char)in[i + c] - 'A';
+            if (v >= ALPHABET_SIZE) return -1;
+            block[c] = (int)v;
+        }
+        hill_multiply_block<N>(k, block, out + i);
+    }
+    return 0;
+}
 
-// --- Fonction main pour démontrer toutes les fonctionnalités ---
-int main() {
-    // --- Tests pour Entropie, Redondance, Incidence de Coïncidence ---
-    const char* text_clair = "CECI EST UN TEST POUR LENTROPIE ET LA REDONDANCE ET LINCIDENCE DE COINCIDENCE";
-    const char* text_chiffre_aleatoire = "ZQWXTJKLMNOIPQRSUVWXZYZABCDEFGH"; // Exemple de texte "aléatoire"
-    const char* text_redondant = "AAAAAAAAAAAAAAAAAAAAAAAAAAAZZAAAAAAAAAAAAAAAAA";
-
-    printf("--- Entropie, Redondance et Incidence de Coïncidence ---\n");
-    printf("Texte: \"%s\"\n", text_clair);
-    printf("  Entropie: %.4f bits/char\n", calculate_entropy(text_clair));
-    printf("  Redondance: %.4f bits/char\n", calculate_redundancy(text_clair));
-    printf("  Incidence de coïncidence: %.4f\n\n", calculate_ic(text_clair));
+/**
+ * @brief Chiffre un texte avec une clé de Hill NxN dans un tampon fourni.
+ * Aucun terminateur n'est écrit.
+ * @param plaintext Le texte clair (octets nuls autorisés).
+ * @param len Le nombre d'octets du texte clair.
+ * @param key La matrice clé NxN (supposée inversible, voir invert_hill_matrix()).
+ * @param out Le tampon de sortie (au moins len + n - 1 octets).
+ * @return Le nombre de lettres chiffrées écrites (multiple de n).
+ */
+size_t encrypt_hill(const char* plaintext, size_t len, const HillMatrix* key, char* out) {
+    // Aiguille vers le noyau spécialisé pour la taille de la clé
+    switch (key->n) {
+        case 2: return hill_encrypt_blocks<2>(key, plaintext, len, out);
+        case 3: return hill_encrypt_blocks<3>(key, plaintext, len, out);
+        case 4: return hill_encrypt_blocks<4>(key, plaintext, len, out);
+        case 5: return hill_encrypt_blocks<5>(key, plaintext, len, out);
+        case 6: return hill_encrypt_blocks<6>(key, plaintext, len, out);
+        case 7: return hill_encrypt_blocks<7>(key, plaintext, len, out);
+        case 8: return hill_encrypt_blocks<8>(key, plaintext, len, out);
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Applique une matrice NxN aux blocs d'un texte majuscule de longueur multiple de n.
+ * @return 0 en cas de succès, -1 si la taille n'est pas supportée ou si un caractère n'est pas une majuscule.
+ */
+static int hill_transform(const HillMatrix* key, const char* in, size_t len, char* out) {
+    switch (key->n) {
+        case 2: return hill_transform_blocks<2>(key, in, len, out);
+        case 3: return hill_transform_blocks<3>(key, in, len, out);
+        case 4: return hill_transform_blocks<4>(key, in, len, out);
+        case 5: return hill_transform_blocks<5>(key, in, len, out);
+        case 6: return hill_transform_blocks<6>(key, in, len, out);
+        case 7: return hill_transform_blocks<7>(key, in, len, out);
+        case 8: return hill_transform_blocks<8>(key, in, len, out);
+        default: return -1;
+    }
+}
+
+/**
+ * @brief Chiffre un texte avec le chiffrement de Hill généralisé (matrice NxN).
+ * Le texte clair est complété avec 'X' jusqu'à un multiple de n lettres.
+ * @param plaintext Le texte clair.
+ * @param key La matrice clé NxN (2 <= n <= HILL_MAX_N).
+ * @return Le texte chiffré alloué dynamiquement, ou NULL en cas d'erreur (clé non inversible).
+ */
+char* encrypt_hill(const char* plaintext, const HillMatrix* key) {
+    HillMatrix inverse;
+    if (invert_hill_matrix(key, &inverse) == -1) {
+        fprintf(stderr, "Erreur Hill: Matrice clé %dx%d non inversible modulo %d.\n", key->n, key->n, ALPHABET_SIZE);
+        return NULL;
+    }
+
+    size_t len = strlen(plaintext);
+    // Au plus len lettres, + n - 1 pour le padding, +1 pour '\0'
+    char* ciphertext = (char*)malloc((len + key->n) * sizeof(char));
+    if (ciphertext == NULL) { perror("Échec d'allocation mémoire"); return NULL; }
+
+    size_t cipher_len = encrypt_hill(plaintext, len, key, ciphertext);
+    ciphertext[cipher_len] = '\0';
+    return ciphertext;
+}
+
+/**
+ * @brief Déchiffre un texte chiffré avec le chiffrement de Hill généralisé (matrice NxN).
+ * @param ciphertext Le texte chiffré (majuscules, longueur multiple de n).
+ * @param key La matrice clé utilisée pour le chiffrement.
+ * @return Le texte clair alloué dynamiquement, ou NULL en cas d'erreur.
+ */
+char* decrypt_hill(const char* ciphertext, const HillMatrix* key) {
+    size_t cipher_len = strlen(ciphertext);
+    if (key->n < 2 || key->n > HILL_MAX_N || cipher_len % key->n != 0) {
+        fprintf(stderr, "Erreur Hill: Longueur du texte chiffré non multiple de %d.\n", key->n);
+        return NULL;
+    }
+
+    // Calcule l'inverse de la matrice clé par élimination de Gauss modulaire
+    HillMatrix inverse;
+    if (invert_hill_matrix(key, &inverse) == -1) {
+        fprintf(stderr, "Erreur Hill: Matrice clé %dx%d non inversible modulo %d.\n", key->n, key->n, ALPHABET_SIZE);
+        return NULL;
+    }
+
+    char* plaintext = (char*)malloc((cipher_len + 1) * sizeof(char));
+    if (plaintext == NULL) { perror("Échec d'allocation mémoire"); return NULL; }
+
+    if (hill_transform(&inverse, ciphertext, cipher_len, plaintext) == -1) {
+        fprintf(stderr, "Erreur Hill: Caractère non alphabétique dans le texte chiffré.\n");
+        free(plaintext);
+        return NULL;
+    }
+    plaintext[cipher_len] = '\0';
+    return plaintext;
+}
+
+// --- 2.3 Moteur de substitution par table compilée ---
+
+// Clé monoalphabétique "compilée" : table de traduction de 256 octets.
+// La table est vue comme 16 lignes de 16 octets (quartet haut = ligne,
+// quartet bas = colonne) ; 'active_rows' marque les lignes qui diffèrent
+// de l'identité, les seules que les noyaux SIMD doivent traiter.
+typedef struct {
+    uint8_t map[256];
+    uint16_t active_rows;
+} SubstitutionTable;
+
+/**
+ * @brief Recalcule le masque des lignes non identitaires d'une table.
+ * @param table La table à mettre à jour.
+ */
+static void update_active_rows(SubstitutionTable* table) {
+    table->active_rows = 0;
+    for (int i = 0; i < 256; i++) {
+        if (table->map[i] != i) {
+            table->active_rows |= (uint16_t)(1u << (i >> 4));
+        }
+    }
+}
+
+/**
+ * @brief Compile une substitution à partir d'une permutation de l'alphabet.
+ * La casse est conservée, les autres octets sont laissés inchangés.
+ * @param table La table à remplir.
+ * @param permutation Les images de 'A'..'Z' (26 lettres distinctes, casse indifférente).
+ * @return 0 en cas de succès, -1 si 'permutation' n'est pas une permutation de l'alphabet.
+ */
+int compile_permutation_table(SubstitutionTable* table, const char permutation[ALPHABET_SIZE]) {
+    int seen[ALPHABET_SIZE] = {0};
+    for (int i = 0; i < ALPHABET_SIZE; i++) {
+        int c = toupper((unsigned char)permutation[i]);
+        if (c < 'A' || c > 'Z' || seen[c - 'A']) {
+            return -1;
+        }
+        seen[c - 'A'] = 1;
+    }
+
+    for (int i = 0; i < 256; i++) {
+        table->map[i] = (uint8_t)i;
+    }
+    for (int i = 0; i < ALPHABET_SIZE; i++) {
+        int p = toupper((unsigned char)permutation[i]) - 'A';
+        table->map['A' + i] = (uint8_t)('A' + p);
+        table->map['a' + i] = (uint8_t)('a' + p);
+    }
+    update_active_rows(table);
+    return 0;
+}
+
+/**
+ * @brief Compile une clé affine (a, b) : E(P) = (a * P + b) mod 26.
+ * @param table La table à remplir.
+ * Les clés sont d'abord réduites modulo 26 (a = -3 équivaut à a = 23) : tous
+ * les points d'entrée affines passent par cette fonction et acceptent donc les
+ * mêmes clés.
+ * @param a Clé multiplicative (doit être coprime avec 26).
+ * @param b Clé additive.
+ * @return 0 en cas de succès, -1 si 'a' n'est pas inversible modulo 26.
+ */
+int compile_affine_table(SubstitutionTable* table, int a, int b) {
+    a = (a % ALPHABET_SIZE + ALPHABET_SIZE) % ALPHABET_SIZE;
+    b = (b % ALPHABET_SIZE + ALPHABET_SIZE) % ALPHABET_SIZE;
+    if (modInverse(a, ALPHABET_SIZE) == -1) {
+        return -1;
+    }
+    char permutation[ALPHABET_SIZE];
+    for (int p = 0; p < ALPHABET_SIZE; p++) {
+        int c = (a * p + b) % ALPHABET_SIZE;
+        if (c < 0) c += ALPHABET_SIZE; // Assure un résultat positif
+        permutation[p] = (char)('A' + c);
+    }
+    return compile_permutation_table(table, permutation);
+}
+
+/**
+ * @brief Compile un décalage de César (cas particulier affine avec a = 1).
+ * @param table La table à remplir.
+ * @param shift Le décalage, éventuellement négatif.
+ */
+void compile_cesar_table(SubstitutionTable* table, int shift) {
+    compile_affine_table(table, 1, shift);
+}
+
+/**
+ * @brief Calcule la table inverse (clé de déchiffrement) d'une table compilée.
+ * Les tables produites par les fonctions compile_* sont des bijections.
+ * @param table La table de chiffrement.
+ * @param inverse La table de déchiffrement à remplir.
+ */
+void invert_substitution_table(const SubstitutionTable* table, SubstitutionTable* inverse) {
+    for (int i = 0; i < 256; i++) {
+        inverse->map[table->map[i]] = (uint8_t)i;
+    }
+    update_active_rows(inverse);
+}
+
+// Signature commune des noyaux d'application de table (in == out autorisé).
+typedef void (*substitution_kernel_fn)(const SubstitutionTable* table, const char* in, char* out, size_t len);
+
+/**
+ * @brief Noyau scalaire : une consultation de table par octet.
+ */
+static void substitution_kernel_scalar(const SubstitutionTable* table, const char* in, char* out, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        out[i] = (char)table->map[(uint8_t)in[i]];
+    }
+}
+
+#if CRYPTO_HAVE_X86_SIMD
+/**
+ * @brief Noyau SSSE3 : consultation par quartets avec pshufb, 16 octets par itération.
+ * Pour chaque ligne active, pshufb indexe la ligne par le quartet bas et le
+ * résultat n'est retenu que pour les octets dont le quartet haut désigne cette ligne.
+ * La sélection se fait par masques (and / andnot / or) : pblendvb, propre à
+ * SSE4.1, n'est pas nécessaire.
+ */
+__attribute__((target("ssse3")))
+static void substitution_kernel_ssse3(const SubstitutionTable* table, const char* in, char* out, size_t len) {
+    __m128i rows[16];
+    int row_ids[16];
+    int row_count = 0;
+    for (int r = 0; r < 16; r++) {
+        if (table->active_rows & (1u << r)) {
+            rows[row_count] = _mm_loadu_si128((const __m128i*)(table->map + 16 * r));
+            row_ids[row_count] = r;
+            row_count++;
+        }
+    }
+    const __m128i low_mask = _mm_set1_epi8(0x0F);
+
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(in + i));
+        __m128i lo = _mm_and_si128(x, low_mask);
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), low_mask);
+        __m128i result = x;
+        for (int r = 0; r < row_count; r++) {
+            __m128i in_row = _mm_cmpeq_epi8(hi, _mm_set1_epi8((char)row_ids[r]));
+            result = _mm_or_si128(_mm_andnot_si128(in_row, result),
+                                  _mm_and_si128(in_row, _mm_shuffle_epi8(rows[r], lo)));
+        }
+        _mm_storeu_si128((__m128i*)(out + i), result);
+    }
+    substitution_kernel_scalar(table, in + i, out + i, len - i);
+}
+
+/**
+ * @brief Noyau AVX2 : même algorithme que le noyau SSSE3, sur 32 octets.
+ */
+__attribute__((target("avx2")))
+static void substitution_kernel_avx2(const SubstitutionTable* table, const char* in, char* out, size_t len) {
+    __m256i rows[16];
+    int row_ids[16];
+    int row_count = 0;
+    for (int r = 0; r < 16; r++) {
+        if (table->active_rows & (1u << r)) {
+            // vpshufb opère par voie de 128 bits : la ligne est dupliquée dans les deux voies.
+            rows[row_count] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(table->map + 16 * r)));
+            row_ids[row_count] = r;
+            row_count++;
+        }
+    }
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(in + i));
+        __m256i lo = _mm256_and_si256(x, low_mask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), low_mask);
+        __m256i result = x;
+        for (int r = 0; r < row_count; r++) {
+            __m256i in_row = _mm256_cmpeq_epi8(hi, _mm256_set1_epi8((char)row_ids[r]));
+            result = _mm256_blendv_epi8(result, _mm256_shuffle_epi8(rows[r], lo), in_row);
+        }
+        _mm256_storeu_si256((__m256i*)(out + i), result);
+    }
+    substitution_kernel_ssse3(table, in + i, out + i, len - i);
+}
+#endif
+
+/**
+ * @brief Choisit le noyau de substitution le plus rapide supporté par le processeur.
+ */
+static substitution_kernel_fn select_substitution_kernel() {
+#if CRYPTO_HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return substitution_kernel_avx2;
+    if (__builtin_cpu_supports("ssse3")) return substitution_kernel_ssse3;
+#endif
+    return substitution_kernel_scalar;
+}
+
+// Noyau sélectionné une seule fois au démarrage du programme.
+static const substitution_kernel_fn substitution_kernel = select_substitution_kernel();
+
+/**
+ * @brief Applique une table compilée à 'len' octets (aucune allocation, in == out autorisé).
+ * @param table La table de substitution.
+ * @param in Le texte source.
+ * @param out Le tampon de sortie (au moins 'len' octets).
+ * @param len Le nombre d'octets à traiter.
+ */
+void apply_substitution(const SubstitutionTable* table, const char* in, char* out, size_t len) {
+    substitution_kernel(table, in, out, len);
+}
+
+// --- 2.4 Le chiffrement affine ---
+
+/**
+ * @brief Chiffre un texte clair avec le chiffrement affine.
+ * @param plaintext Le texte clair.
+ * @param a Clé multiplicative (doit être coprime avec 26).
+ * @param b Clé additive.
+ * @return Le texte chiffré alloué dynamiquement, ou NULL en cas d'erreur.
+ */
+char* encrypt_affine(const char* plaintext, int a, int b) {
+    // Vérifie que 'a' est inversible modulo 26
+    SubstitutionTable table;
+    if (compile_affine_table(&table, a, b) == -1) {
+        fprintf(stderr, "Erreur Affine: Clé 'a' (%d) non inversible modulo %d.\n", a, ALPHABET_SIZE);
+        return NULL;
+    }
+
+    size_t len = strlen(plaintext);
+    char* ciphertext = (char*)malloc((len + 1) * sizeof(char));
+    if (ciphertext == NULL) { perror("Échec d'allocation mémoire"); return NULL; }
+
+    // Chiffre tous les caractères par consultation de la table (non-alphabétiques inchangés).
+    apply_substitution(&table, plaintext, ciphertext, len);
+    ciphertext[len] = '\0';
+    return ciphertext;
+}
+
+/**
+ * @brief Déchiffre un texte chiffré avec le chiffrement affine.
+ * @param ciphertext Le texte chiffré.
+ * @param a Clé multiplicative.
+ * @param b Clé additive.
+ * @return Le texte clair alloué dynamiquement, ou NULL en cas d'erreur.
+ */
+char* decrypt_affine(const char* ciphertext, int a, int b) {
+    SubstitutionTable table, inverse;
+    if (compile_affine_table(&table, a, b) == -1) {
+        fprintf(stderr, "Erreur Affine: Clé 'a' (%d) non inversible modulo %d.\n", a, ALPHABET_SIZE);
+        return NULL;
+    }
+    // La table inverse réalise P = a_inv * (C - b) mod 26.
+    invert_substitution_table(&table, &inverse);
+
+    size_t len = strlen(ciphertext);
+    char* plaintext = (char*)malloc((len + 1) * sizeof(char));
+    if (plaintext == NULL) { perror("Échec d'allocation mémoire"); return NULL; }
+
+    // Déchiffre tous les caractères par consultation de la table inverse.
+    apply_substitution(&inverse, ciphertext, plaintext, len);
+    plaintext[len] = '\0';
+    return plaintext;
+}
+
+
+// --- 2.5 Chiffrement affine en flux (mémoire constante) ---
+
+// Contexte de chiffrement affine en flux : la clé est compilée une fois en
+// table de substitution, appliquée ensuite morceau par morceau.
+typedef struct {
+    SubstitutionTable table;
+} AffineStream;
+
+/**
+ * @brief Initialise un contexte de chiffrement affine en flux.
+ * @param ctx Le contexte à initialiser.
+ * @param a Clé multiplicative (doit être coprime avec 26).
+ * @param b Clé additive.
+ * @param decrypt 0 pour chiffrer, 1 pour déchiffrer.
+ * @return 0 en cas de succès, -1 si 'a' n'est pas inversible modulo 26.
+ */
+int affine_stream_init(AffineStream* ctx, int a, int b, int decrypt) {
+    SubstitutionTable table;
+    if (compile_affine_table(&table, a, b) == -1) {
+        fprintf(stderr, "Erreur Affine: Clé 'a' (%d) non inversible modulo %d.\n", a, ALPHABET_SIZE);
+        return -1;
+    }
+    if (decrypt) {
+        invert_substitution_table(&table, &ctx->table);
+    } else {
+        ctx->table = table;
+    }
+    return 0;
+}
+
+/**
+ * @brief Chiffre un morceau du flux (aucune allocation, in == out autorisé).
+ * @param ctx Le contexte initialisé par affine_stream_init().
+ * @param in Le morceau à traiter.
+ * @param len Le nombre d'octets du morceau.
+ * @param out Le tampon de sortie (au moins 'len' octets).
+ */
+void affine_stream_update(AffineStream* ctx, const char* in, size_t len, char* out) {
+    apply_substitution(&ctx->table, in, out, len);
+}
+
+/**
+ * @brief Termine le flux. Le chiffrement affine ne retenant aucun octet, rien n'est à vider.
+ * @param ctx Le contexte à terminer.
+ * @return Le nombre d'octets restant à écrire (toujours 0).
+ */
+size_t affine_stream_final(AffineStream* ctx) {
+    (void)ctx;
+    return 0;
+}
+
+/**
+ * @brief Écrit l'intégralité d'un tampon sur un descripteur (gère les écritures partielles).
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+static int write_all(int fd, const char* buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Chiffre tout le contenu d'un descripteur vers un autre, par tampons de taille fixe.
+ * La mémoire utilisée est constante quelle que soit la taille de l'entrée.
+ * @param in_fd Le descripteur source.
+ * @param out_fd Le descripteur destination.
+ * @param a Clé multiplicative (doit être coprime avec 26).
+ * @param b Clé additive.
+ * @return 0 en cas de succès, -1 en cas d'erreur (clé invalide ou entrée/sortie).
+ */
+int encrypt_affine_fd(int in_fd, int out_fd, int a, int b) {
+    AffineStream ctx;
+    if (affine_stream_init(&ctx, a, b, 0) == -1) {
+        return -1;
+    }
+
+    char buffer[STREAM_BUFFER_SIZE];
+    for (;;) {
+        ssize_t n = read(in_fd, buffer, sizeof(buffer));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("Erreur de lecture");
+            return -1;
+        }
+        if (n == 0) break; // Fin du flux
+        affine_stream_update(&ctx, buffer, (size_t)n, buffer);
+        if (write_all(out_fd, buffer, (size_t)n) == -1) {
+            perror("Erreur d'écriture");
+            return -1;
+        }
+    }
+    affine_stream_final(&ctx);
+    return 0;
+}
+
+// --- 2.6 Chiffrement affine par lots ---
+
+// Message d'un lot : une tranche de l'arène d'entrée et sa propre clé affine.
+// Le résultat est écrit à la même position dans l'arène de sortie.
+typedef struct {
+    size_t offset; // Position du message dans l'arène
+    size_t length; // Nombre d'octets du message
+    int a;         // Clé multiplicative (réduite modulo 26, doit être coprime avec 26)
+    int b;         // Clé additive
+} AffineRecord;
+
+/**
+ * @brief Chiffre (ou déchiffre) un lot de messages courts, chacun avec sa propre clé affine.
+ *
+ * Il n'existe que 26 * 26 couples (a mod 26, b mod 26) : une première passe
+ * valide les clés et compile une seule fois la table de substitution de chaque
+ * couple rencontré. Les messages sont ensuite lus dans une même arène contiguë
+ * et écrits dans une arène de sortie de même disposition, sans strlen ni
+ * allocation par message, les enregistrements étant distribués par paquets de
+ * BATCH_CHUNK entre les threads.
+ *
+ * @param in_arena L'arène contenant les messages.
+ * @param out_arena L'arène de sortie (même taille ; in_arena == out_arena autorisé).
+ * @param records Les messages à traiter.
+ * @param count Le nombre de messages.
+ * @param decrypt 0 pour chiffrer, 1 pour déchiffrer.
+ * @return 0 en cas de succès, -1 si une clé 'a' n'est pas inversible (aucun message n'est alors traité) ou en cas d'erreur d'allocation.
+ */
+int encrypt_affine_batch(const char* in_arena, char* out_arena, const AffineRecord* records, size_t count, int decrypt) {
+    SubstitutionTable* tables = (SubstitutionTable*)malloc(DIGRAM_COUNT * sizeof(SubstitutionTable));
+    uint8_t* compiled = (uint8_t*)calloc(DIGRAM_COUNT, sizeof(uint8_t));
+    uint16_t* table_index = (uint16_t*)malloc((count > 0 ? count : 1) * sizeof(uint16_t));
+    if (tables == NULL || compiled == NULL || table_index == NULL) {
+        perror("Échec d'allocation mémoire");
+        free(tables); free(compiled); free(table_index);
+        return -1;
+    }
+
+    // Passe séquentielle : validation et compilation des tables utilisées
+    for (size_t r = 0; r < count; r++) {
+        int a = (records[r].a % ALPHABET_SIZE + ALPHABET_SIZE) % ALPHABET_SIZE;
+        int b = (records[r].b % ALPHABET_SIZE + ALPHABET_SIZE) % ALPHABET_SIZE;
+        uint16_t index = (uint16_t)(a * ALPHABET_SIZE + b);
+        if (!compiled[index]) {
+            SubstitutionTable table;
+            if (compile_affine_table(&table, a, b) == -1) {
+                fprintf(stderr, "Erreur Affine: Clé 'a' (%d) du message %zu non inversible modulo %d.\n",
+                        records[r].a, r, ALPHABET_SIZE);
+                free(tables); free(compiled); free(table_index);
+                return -1;
+            }
+            if (decrypt) {
+                invert_substitution_table(&table, &tables[index]);
+            } else {
+                tables[index] = table;
+            }
+            compiled[index] = 1;
+        }
+        table_index[r] = index;
+    }
+
+    std::atomic<size_t> next_record(0);
+    auto worker = [&](unsigned) {
+        for (size_t first = next_record.fetch_add(BATCH_CHUNK); first < count;
+             first = next_record.fetch_add(BATCH_CHUNK)) {
+            size_t last = first + BATCH_CHUNK < count ? first + BATCH_CHUNK : count;
+            for (size_t r = first; r < last; r++) {
+                apply_substitution(&tables[table_index[r]], in_arena + records[r].offset,
+                                   out_arena + records[r].offset, records[r].length);
+            }
+        }
+    };
+    size_t chunks = (count + BATCH_CHUNK - 1) / BATCH_CHUNK;
+    unsigned thread_count = worker_count(chunks);
+    run_workers(thread_count, worker); // Le thread appelant participe aussi
+
+    free(tables);
+    free(compiled);
+    free(table_index);
+    return 0;
+}
+
+
+// --- 3. Cryptanalyse ---
+
+// Fréquences de référence des lettres A-Z en français
+static const double FRENCH_FREQUENCIES[ALPHABET_SIZE] = {
+    0.07636, 0.00901, 0.03260, 0.03669, 0.14715, 0.01066, 0.00866, 0.00737, 0.07529,
+    0.00613, 0.00074, 0.05456, 0.02968, 0.07095, 0.05796, 0.02521, 0.01362, 0.06693,
+    0.07948, 0.07244, 0.06311, 0.01838, 0.00049, 0.00427, 0.00128, 0.00326
+};
+
+// Fréquences de référence des lettres A-Z en anglais
+static const double ENGLISH_FREQUENCIES[ALPHABET_SIZE] = {
+    0.08167, 0.01492, 0.02782, 0.04253, 0.12702, 0.02228, 0.02015, 0.06094, 0.06966,
+    0.00153, 0.00772, 0.04025, 0.02406, 0.06749, 0.07507, 0.01929, 0.00095, 0.05987,
+    0.06327, 0.09056, 0.02758, 0.00978, 0.02360, 0.00150, 0.01974, 0.00074
+};
+
+/**
+ * @brief Calcule le khi-deux entre des comptes observés et une distribution de référence.
+ * @param counts Les comptes observés, dans l'ordre où ils doivent être comparés à 'reference'.
+ * @param total La somme des comptes.
+ * @param reference Les fréquences attendues (somme égale à 1).
+ * @return La statistique du khi-deux (plus elle est faible, meilleure est l'adéquation).
+ */
+static double chi_squared(const size_t counts[ALPHABET_SIZE], size_t total, const double reference[ALPHABET_SIZE]) {
+    double chi2 = 0.0;
+    for (int l = 0; l < ALPHABET_SIZE; l++) {
+        double expected = total * reference[l];
+        double diff = (double)counts[l] - expected;
+        chi2 += diff * diff / expected;
+    }
+    return chi2;
+}
+
+// --- 3.1 Cassage de César par histogramme ---
+
+// Décalage candidat et son score (khi-deux, plus faible = plus probable)
+typedef struct {
+    int shift;
+    double score;
+} CesarCandidate;
+
+/**
+ * @brief Compare deux candidats par score croissant (pour qsort).
+ */
+static int compare_cesar_candidates(const void* a, const void* b) {
+    double sa = ((const CesarCandidate*)a)->score;
+    double sb = ((const CesarCandidate*)b)->score;
+    return (sa > sb) - (sa < sb);
+}
+
+/**
+ * @brief Retrouve le décalage d'un texte chiffré par César sans le déchiffrer.
+ *
+ * Construit un seul histogramme du texte (O(n)), puis évalue les 26 rotations
+ * de cet histogramme contre la distribution de référence par khi-deux (O(26 x 26)).
+ *
+ * @param ciphertext Le texte chiffré (octets nuls autorisés).
+ * @param len Le nombre d'octets du texte chiffré.
+ * @param reference Les fréquences de la langue attendue (ex. FRENCH_FREQUENCIES).
+ * @param ranked Reçoit les 26 décalages classés du plus au moins probable.
+ * @return Le nombre de lettres analysées (0 : classement sans signification).
+ */
+size_t crack_cesar(const char* ciphertext, size_t len, const double reference[ALPHABET_SIZE],
+                   CesarCandidate ranked[ALPHABET_SIZE]) {
+    size_t counts[ALPHABET_SIZE];
+    letter_histogram(ciphertext, len, counts);
+    size_t total = 0;
+    for (int l = 0; l < ALPHABET_SIZE; l++) {
+        total += counts[l];
+    }
+
+    for (int shift = 0; shift < ALPHABET_SIZE; shift++) {
+        // La lettre claire l apparaît dans le chiffré sous la forme (l + shift) mod 26
+        size_t rotated[ALPHABET_SIZE];
+        for (int l = 0; l < ALPHABET_SIZE; l++) {
+            rotated[l] = counts[(l + shift) % ALPHABET_SIZE];
+        }
+        ranked[shift].shift = shift;
+        ranked[shift].score = total > 0 ? chi_squared(rotated, total, reference) : 0.0;
+    }
+    qsort(ranked, ALPHABET_SIZE, sizeof(CesarCandidate), compare_cesar_candidates);
+    return total;
+}
+
+// --- 3.2 Cassage affine par permutation d'histogramme ---
+
+// Nombre de clés affines valides : 12 valeurs de 'a' coprimes avec 26 x 26 valeurs de 'b'
+#define AFFINE_KEY_COUNT 312
+
+// Méthode de notation des clés candidates
+typedef enum {
+    SCORE_CHI_SQUARED,   // Khi-deux : plus faible = plus probable
+    SCORE_LOG_LIKELIHOOD // Log-vraisemblance : plus élevée = plus probable
+} ScoreMethod;
+
+// Clé affine candidate et son score
+typedef struct {
+    int a;
+    int b;
+    double score;
+} AffineCandidate;
+
+/**
+ * @brief Compare deux candidats par khi-deux croissant (pour qsort).
+ */
+static int compare_affine_chi_squared(const void* x, const void* y) {
+    double sx = ((const AffineCandidate*)x)->score;
+    double sy = ((const AffineCandidate*)y)->score;
+    return (sx > sy) - (sx < sy);
+}
+
+/**
+ * @brief Compare deux candidats par log-vraisemblance décroissante (pour qsort).
+ */
+static int compare_affine_log_likelihood(const void* x, const void* y) {
+    return compare_affine_chi_squared(y, x);
+}
+
+/**
+ * @brief Retrouve les clés affines les plus probables d'un texte chiffré.
+ *
+ * Un seul histogramme du texte est construit ; chacune des 312 clés (a, b) est
+ * ensuite évaluée en permutant les 26 comptes (la lettre claire p apparaît sous
+ * la forme (a * p + b) mod 26), sans jamais déchiffrer le texte.
+ *
+ * @param ciphertext Le texte chiffré (octets nuls autorisés).
+ * @param len Le nombre d'octets du texte chiffré.
+ * @param reference Les fréquences de la langue attendue (ex. FRENCH_FREQUENCIES).
+ * @param method La statistique utilisée pour noter les clés.
+ * @param top Reçoit les meilleures clés, de la plus à la moins probable.
+ * @param k La capacité de 'top'.
+ * @return Le nombre de candidats écrits dans 'top' (min(k, 312)), 0 si le texte ne contient aucune lettre.
+ */
+size_t crack_affine(const char* ciphertext, size_t len, const double reference[ALPHABET_SIZE],
+                    ScoreMethod method, AffineCandidate* top, size_t k) {
+    size_t counts[ALPHABET_SIZE];
+    letter_histogram(ciphertext, len, counts);
+    size_t total = 0;
+    for (int l = 0; l < ALPHABET_SIZE; l++) {
+        total += counts[l];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    double log_reference[ALPHABET_SIZE];
+    for (int l = 0; l < ALPHABET_SIZE; l++) {
+        log_reference[l] = log(reference[l]);
+    }
+
+    AffineCandidate candidates[AFFINE_KEY_COUNT];
+    int n = 0;
+    for (int a = 1; a < ALPHABET_SIZE; a += 2) {
+        if (a == 13) continue; // Seules les valeurs impaires différentes de 13 sont inversibles
+        for (int b = 0; b < ALPHABET_SIZE; b++) {
+            size_t permuted[ALPHABET_SIZE];
+            int c = b; // (a * p + b) mod 26, mis à jour par additions successives
+            for (int p = 0; p < ALPHABET_SIZE; p++) {
+                permuted[p] = counts[c];
+                c += a;
+                if (c >= ALPHABET_SIZE) c -= ALPHABET_SIZE;
+            }
+
+            double score;
+            if (method == SCORE_CHI_SQUARED) {
+                score = chi_squared(permuted, total, reference);
+            } else {
+                score = 0.0;
+                for (int p = 0; p < ALPHABET_SIZE; p++) {
+                    score += permuted[p] * log_reference[p];
+                }
+            }
+            candidates[n].a = a;
+            candidates[n].b = b;
+            candidates[n].score = score;
+            n++;
+        }
+    }
+
+    qsort(candidates, AFFINE_KEY_COUNT, sizeof(AffineCandidate),
+          method == SCORE_CHI_SQUARED ? compare_affine_chi_squared : compare_affine_log_likelihood);
+    size_t written = k < AFFINE_KEY_COUNT ? k : AFFINE_KEY_COUNT;
+    memcpy(top, candidates, written * sizeof(AffineCandidate));
+    return written;
+}
+
+// --- 3.3 Attaque de Hill 2x2 à clair connu ---
+
+// Position probable d'un mot connu (crib) et clé de Hill qui en découle
+typedef struct {
+    size_t offset;  // Position (en lettres) du crib dans le texte chiffré
+    Matrix2x2 key;  // Clé cohérente avec tous les digrammes du crib
+    double score;   // Khi-deux du déchiffrement complet (plus faible = plus probable)
+} HillCribMatch;
+
+/**
+ * @brief Résout K = C * P^-1 à partir de deux digrammes clairs et chiffrés.
+ * Les digrammes forment les colonnes des matrices P et C.
+ * @param p Les deux digrammes clairs (p[0] = premier digramme), lettres 0-25.
+ * @param c Les deux digrammes chiffrés correspondants.
+ * @param key Reçoit la clé.
+ * @return 0 en cas de succès, -1 si P n'est pas inversible ou si la clé obtenue ne l'est pas.
+ */
+static int solve_hill_from_digrams(const int p[2][2], const int c[2][2], Matrix2x2* key) {
+    // P = [p0 p1] (colonnes), det(P) doit être inversible modulo 26
+    int det = (p[0][0] * p[1][1] - p[1][0] * p[0][1]) % ALPHABET_SIZE;
+    if (det < 0) det += ALPHABET_SIZE;
+    int det_inv = modInverse(det, ALPHABET_SIZE);
+    if (det_inv == -1) {
+        return -1;
+    }
+
+    // P^-1 = det^-1 * adj(P)
+    int p_inv[2][2] = {
+        { (p[1][1] * det_inv) % ALPHABET_SIZE, ((ALPHABET_SIZE - p[1][0]) * det_inv) % ALPHABET_SIZE },
+        { ((ALPHABET_SIZE - p[0][1]) * det_inv) % ALPHABET_SIZE, (p[0][0] * det_inv) % ALPHABET_SIZE }
+    };
+
+    // K = C * P^-1, avec C = [c0 c1] (colonnes)
+    for (int r = 0; r < 2; r++) {
+        for (int col = 0; col < 2; col++) {
+            key->mat[r][col] = (c[0][r] * p_inv[0][col] + c[1][r] * p_inv[1][col]) % ALPHABET_SIZE;
+        }
+    }
+    return modInverse(hill_determinant(*key), ALPHABET_SIZE) == -1 ? -1 : 0;
+}
+
+/**
+ * @brief Résout une clé de Hill 2x2 sur des digrammes déjà validés (aucun message d'erreur).
+ * Choisit deux digrammes dont la matrice est inversible, en déduit la clé puis
+ * la vérifie sur tous les autres digrammes.
+ * @return 0 en cas de succès, -1 si aucune clé cohérente n'existe.
+ */
+static int solve_hill_digrams(const char* plaintext, const char* ciphertext, size_t digrams, Matrix2x2* key) {
+    for (size_t a = 0; a < digrams; a++) {
+        for (size_t b = a + 1; b < digrams; b++) {
+            int p[2][2] = {
+                { plaintext[2 * a] - 'A', plaintext[2 * a + 1] - 'A' },
+                { plaintext[2 * b] - 'A', plaintext[2 * b + 1] - 'A' }
+            };
+            int c[2][2] = {
+                { ciphertext[2 * a] - 'A', ciphertext[2 * a + 1] - 'A' },
+                { ciphertext[2 * b] - 'A', ciphertext[2 * b + 1] - 'A' }
+            };
+            Matrix2x2 candidate;
+            if (solve_hill_from_digrams(p, c, &candidate) == -1) {
+                continue;
+            }
+
+            // Vérifie la clé sur tous les digrammes
+            size_t t = 0;
+            for (; t < digrams; t++) {
+                int p1 = plaintext[2 * t] - 'A', p2 = plaintext[2 * t + 1] - 'A';
+                int c1 = (candidate.mat[0][0] * p1 + candidate.mat[0][1] * p2) % ALPHABET_SIZE;
+                int c2 = (candidate.mat[1][0] * p1 + candidate.mat[1][1] * p2) % ALPHABET_SIZE;
+                if (c1 != ciphertext[2 * t] - 'A' || c2 != ciphertext[2 * t + 1] - 'A') break;
+            }
+            if (t == digrams) {
+                *key = candidate;
+                return 0;
+            }
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Retrouve une clé de Hill 2x2 à partir d'un clair et du chiffré correspondant.
+ *
+ * Choisit automatiquement deux digrammes dont la matrice est inversible, en
+ * déduit la clé puis la vérifie sur tous les autres digrammes du texte.
+ *
+ * @param plaintext Le texte clair (majuscules A-Z).
+ * @param ciphertext Le texte chiffré aligné (majuscules A-Z).
+ * @param len Le nombre de lettres communes à examiner (les lettres au-delà du dernier digramme complet sont ignorées).
+ * @param key Reçoit la clé retrouvée.
+ * @return 0 en cas de succès, -1 si aucune clé cohérente n'existe.
+ */
+int solve_hill_known_plaintext(const char* plaintext, const char* ciphertext, size_t len, Matrix2x2* key) {
+    size_t digrams = len / 2;
+    for (size_t i = 0; i < 2 * digrams; i++) {
+        if ((unsigned)(plaintext[i] - 'A') >= ALPHABET_SIZE || (unsigned)(ciphertext[i] - 'A') >= ALPHABET_SIZE) {
+            fprintf(stderr, "Erreur Hill: Les textes doivent ne contenir que des majuscules.\n");
+            return -1;
+        }
+    }
+    return solve_hill_digrams(plaintext, ciphertext, digrams, key);
+}
+
+/**
+ * @brief Cherche la position d'un mot connu (crib) dans un texte chiffré par Hill 2x2.
+ *
+ * Chaque position possible du crib est essayée : la clé est résolue sur les
+ * digrammes entièrement couverts par le crib (au moins 2) et vérifiée sur les
+ * autres. Chaque clé cohérente est notée par le khi-deux du déchiffrement
+ * complet, obtenu par la table de digrammes.
+ *
+ * @param ciphertext Le texte chiffré (majuscules A-Z, longueur paire).
+ * @param crib Le mot ou la phrase supposé présent dans le clair (non-lettres ignorées, au moins 4 lettres).
+ * @param reference Les fréquences de la langue attendue (ex. FRENCH_FREQUENCIES).
+ * @param matches Reçoit les meilleures positions, de la plus à la moins probable.
+ * @param max_matches La capacité de 'matches'.
+ * @return Le nombre de positions écrites dans 'matches' (0 si le texte chiffré est invalide).
+ */
+size_t search_hill_crib(const char* ciphertext, const char* crib, const double reference[ALPHABET_SIZE],
+                        HillCribMatch* matches, size_t max_matches) {
+    size_t n = strlen(ciphertext);
+    // Validation unique du texte chiffré : les positions essayées ensuite ne peuvent plus échouer pour cette raison
+    if (n % 2 != 0) {
+        fprintf(stderr, "Erreur Hill: Longueur du texte chiffré impaire.\n");
+        return 0;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if ((unsigned)(ciphertext[i] - 'A') >= ALPHABET_SIZE) {
+            fprintf(stderr, "Erreur Hill: Caractère non alphabétique dans le texte chiffré.\n");
+            return 0;
+        }
+    }
+    size_t crib_len = strlen(crib);
+    char* crib_letters = (char*)malloc(crib_len + 1);
+    char* scratch = (char*)malloc(n + 1);
+    if (crib_letters == NULL || scratch == NULL) {
+        perror("Échec d'allocation mémoire");
+        free(crib_letters); free(scratch);
+        return 0;
+    }
+    size_t m = 0;
+    for (size_t i = 0; i < crib_len; i++) {
+        unsigned letter = ((unsigned char)crib[i] | 0x20) - 'a';
+        if (letter < ALPHABET_SIZE) crib_letters[m++] = (char)('A' + letter);
+    }
+    if (m < 4) {
+        // Deux digrammes complets au moins sont nécessaires pour résoudre la clé
+        free(crib_letters);
+        free(scratch);
+        return 0;
+    }
+
+    size_t found = 0;
+    for (size_t offset = 0; offset + m <= n; offset++) {
+        // Les digrammes chiffrés commencent aux positions paires
+        size_t start = offset + (offset & 1);
+        if (offset + m < start + 4) continue;
+        size_t span = (offset + m - start) & ~(size_t)1;
+
+        Matrix2x2 key;
+        if (solve_hill_digrams(crib_letters + (start - offset), ciphertext + start, span / 2, &key) == -1) {
+            continue;
+        }
+
+        HillDigramTable table;
+        compile_hill_table(key, &table);
+        decrypt_hill(ciphertext, n, &table, scratch); // Texte déjà validé
+        size_t counts[ALPHABET_SIZE];
+        letter_histogram(scratch, n, counts);
+        double score = chi_squared(counts, n, reference);
+
+        // Insère le candidat dans la liste triée des meilleurs
+        size_t pos = found < max_matches ? found : max_matches;
+        while (pos > 0 && matches[pos - 1].score > score) {
+            if (pos < max_matches) matches[pos] = matches[pos - 1];
+            pos--;
+        }
+        if (pos < max_matches) {
+            matches[pos].offset = offset;
+            matches[pos].key = key;
+            matches[pos].score = score;
+            if (found < max_matches) found++;
+        }
+    }
+    free(crib_letters);
+    free(scratch);
+    return found;
+}
+
+// --- 3.4 Recherche exhaustive des clés de Hill 2x2 ---
+
+// Texte français de référence, utilisé pour construire un modèle de bigrammes
+// par défaut. Un corpus plus long donne des statistiques plus fiables.
+static const char FRENCH_REFERENCE_TEXT[] =
+    "La cryptographie est une des disciplines de la cryptologie s'attachant a proteger des messages "
+    "en assurant leur confidentialite, leur authenticite et leur integrite, en s'aidant souvent de "
+    "secrets ou cles. Elle se distingue de la steganographie qui fait passer inapercu un message dans "
+    "un autre message alors que la cryptographie rend un message supposement inintelligible a autre "
+    "que qui de droit. Elle est utilisee depuis l'Antiquite, mais certaines de ses methodes les plus "
+    "importantes, comme la cryptographie asymetrique, datent de la fin du vingtieme siecle. Les "
+    "premiers documents chiffres connus remontent a l'Antiquite. Le plus ancien est une tablette "
+    "d'argile, trouvee en Irak, et datant du seizieme siecle avant notre ere. Un potier y avait grave "
+    "sa recette secrete en supprimant des consonnes et en modifiant l'orthographe des mots. Le "
+    "chiffrement de Vigenere est un systeme de chiffrement par substitution polyalphabetique dans "
+    "lequel une meme lettre du message clair peut, suivant sa position dans celui-ci, etre remplacee "
+    "par des lettres differentes, contrairement a un systeme de chiffrement monoalphabetique comme le "
+    "chiffre de Cesar. Cette methode resiste ainsi a l'analyse de frequences, ce qui est un avantage "
+    "decisif sur les chiffrements monoalphabetiques. Cependant le chiffre de Vigenere a ete perce par "
+    "le major prussien Friedrich Kasiski qui a publie sa methode en mil huit cent soixante trois. "
+    "Depuis cette epoque, il n'offre plus aucune securite. Il est nomme ainsi au dix-neuvieme siecle "
+    "en reference au diplomate du seizieme siecle Blaise de Vigenere, qui le decrit parmi d'autres "
+    "dans son traite des chiffres paru en mil cinq cent quatre-vingt-six.";
+
+// Modèle de langue à bigrammes : log-probabilité de chaque couple de lettres consécutives
+typedef struct {
+    float logp[ALPHABET_SIZE][ALPHABET_SIZE];
+    float max_logp; // Plus grande log-probabilité (borne pour l'élagage)
+} BigramModel;
+
+// Clé de Hill 2x2 candidate et son score (log-vraisemblance, plus élevée = plus probable)
+typedef struct {
+    Matrix2x2 key;
+    double score;
+} Hill2Candidate;
+
+/**
+ * @brief Construit un modèle de bigrammes à partir d'un corpus (lissage de Laplace).
+ * Les non-lettres sont ignorées : deux lettres séparées par une ponctuation forment un bigramme.
+ * @param corpus Le texte de référence.
+ * @param len Le nombre d'octets du corpus.
+ * @param model Le modèle à remplir.
+ */
+void build_bigram_model(const char* corpus, size_t len, BigramModel* model) {
+    size_t counts[ALPHABET_SIZE][ALPHABET_SIZE] = {{0}};
+    size_t total = 0;
+    int previous = -1;
+    for (size_t i = 0; i < len; i++) {
+        unsigned letter = ((unsigned char)corpus[i] | 0x20) - 'a';
+        if (letter >= ALPHABET_SIZE) continue;
+        if (previous >= 0) {
+            counts[previous][letter]++;
+            total++;
+        }
+        previous = (int)letter;
+    }
+
+    model->max_logp = -INFINITY;
+    for (int a = 0; a < ALPHABET_SIZE; a++) {
+        for (int b = 0; b < ALPHABET_SIZE; b++) {
+            model->logp[a][b] = (float)log((counts[a][b] + 1.0) / (total + DIGRAM_COUNT));
+            if (model->logp[a][b] > model->max_logp) model->max_logp = model->logp[a][b];
+        }
+    }
+}
+
+/**
+ * @brief Insère un candidat dans une liste triée (score décroissant) de capacité k.
+ * @return Le nouveau nombre d'éléments de la liste.
+ */
+static size_t insert_hill2_candidate(Hill2Candidate* list, size_t count, size_t k, Hill2Candidate candidate) {
+    size_t pos = count < k ? count : k;
+    while (pos > 0 && list[pos - 1].score < candidate.score) {
+        if (pos < k) list[pos] = list[pos - 1];
+        pos--;
+    }
+    if (pos < k) {
+        list[pos] = candidate;
+        if (count < k) count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Casse un texte chiffré par Hill 2x2 en essayant toutes les clés inversibles.
+ *
+ * Les 157 248 matrices de déchiffrement inversibles modulo 26 sont énumérées
+ * par couples de lignes. Une ligne (x, y) produit à elle seule une lettre sur
+ * deux du clair, (x * c1 + y * c2) mod 26 : les 676 lignes possibles sont
+ * précalculées une fois sur le préfixe, si bien que déchiffrer le préfixe avec
+ * une clé se réduit à des consultations de table. Chaque clé est notée par la
+ * log-vraisemblance en bigrammes du préfixe déchiffré ; la notation s'arrête dès
+ * que le score partiel, complété par la meilleure log-probabilité possible, ne
+ * peut plus battre le k-ième meilleur. Les premières lignes sont réparties
+ * entre tous les cœurs.
+ *
+ * @param ciphertext Le texte chiffré (majuscules A-Z, longueur paire).
+ * @param model Le modèle de bigrammes de la langue attendue.
+ * @param prefix_letters Le nombre de lettres du préfixe noté (0 : 200 lettres).
+ * @param top Reçoit les meilleures clés de chiffrement, de la plus à la moins probable.
+ * @param k La capacité de 'top'.
+ * @return Le nombre de candidats écrits dans 'top', 0 en cas d'erreur.
+ */
+size_t crack_hill2(const char* ciphertext, const BigramModel* model, size_t prefix_letters,
+                   Hill2Candidate* top, size_t k) {
+    size_t n = strlen(ciphertext);
+    if (prefix_letters == 0) prefix_letters = 200;
+    if (prefix_letters > n) prefix_letters = n;
+    size_t digrams = prefix_letters / 2;
+    if (digrams < 2 || k == 0) {
+        return 0;
+    }
+    for (size_t i = 0; i < 2 * digrams; i++) {
+        if ((unsigned)(ciphertext[i] - 'A') >= ALPHABET_SIZE) {
+            fprintf(stderr, "Erreur Hill: Caractère non alphabétique dans le texte chiffré.\n");
+            return 0;
+        }
+    }
+
+    // rows[(x * 26 + y) * digrams + t] = (x * c1_t + y * c2_t) mod 26
+    uint8_t* rows = (uint8_t*)malloc(DIGRAM_COUNT * digrams);
+    if (rows == NULL) {
+        perror("Échec d'allocation mémoire");
+        return 0;
+    }
+    for (int x = 0; x < ALPHABET_SIZE; x++) {
+        for (int y = 0; y < ALPHABET_SIZE; y++) {
+            uint8_t* row = rows + (x * ALPHABET_SIZE + y) * digrams;
+            for (size_t t = 0; t < digrams; t++) {
+                row[t] = (uint8_t)((x * (ciphertext[2 * t] - 'A') + y * (ciphertext[2 * t + 1] - 'A')) % ALPHABET_SIZE);
+            }
+        }
+    }
+
+    // Inversibilité modulo 26 : déterminant impair et différent de 13
+    int is_unit[ALPHABET_SIZE];
+    for (int v = 0; v < ALPHABET_SIZE; v++) {
+        is_unit[v] = (v % 2 == 1) && (v != 13);
+    }
+
+    unsigned thread_count = worker_count(DIGRAM_COUNT);
+    Hill2Candidate* local_top = (Hill2Candidate*)malloc(thread_count * k * sizeof(Hill2Candidate));
+    size_t* local_count = (size_t*)calloc(thread_count, sizeof(size_t));
+    if (local_top == NULL || local_count == NULL) {
+        perror("Échec d'allocation mémoire");
+        free(rows); free(local_top); free(local_count);
+        return 0;
+    }
+
+    const float max_logp = model->max_logp;
+    std::atomic<int> next_row(0);
+    auto worker = [&](unsigned id) {
+        Hill2Candidate* best = local_top + id * k;
+        size_t count = 0;
+        for (int r0 = next_row++; r0 < DIGRAM_COUNT; r0 = next_row++) {
+            const uint8_t* first = rows + r0 * digrams;
+            int a = r0 / ALPHABET_SIZE, b = r0 % ALPHABET_SIZE;
+            for (int r1 = 0; r1 < DIGRAM_COUNT; r1++) {
+                int c = r1 / ALPHABET_SIZE, d = r1 % ALPHABET_SIZE;
+                int det = ((a * d - b * c) % ALPHABET_SIZE + ALPHABET_SIZE) % ALPHABET_SIZE;
+                if (!is_unit[det]) continue;
+
+                const uint8_t* second = rows + r1 * digrams;
+                double threshold = count == k ? best[k - 1].score : -INFINITY;
+                double score = 0.0;
+                size_t t = 0;
+                for (; t < digrams; t++) {
+                    score += model->logp[first[t]][second[t]];
+                    if (t + 1 < digrams) score += model->logp[second[t]][first[t + 1]];
+                    // Élagage : même avec les meilleurs bigrammes, le reste ne suffirait pas
+                    // (il reste 2 * (digrams - 1 - t) - 1 bigrammes à noter)
+                    if ((t & 7) == 7 && t + 1 < digrams &&
+                        score + (double)max_logp * (2 * (digrams - 1 - t) - 1) < threshold) break;
+                }
+                if (t < digrams) continue;
+
+                // La matrice (a b / c d) déchiffre : la clé de chiffrement est son inverse
+                HillMatrix decryption = {2, {{a, b}, {c, d}}};
+                HillMatrix encryption;
+                invert_hill_matrix(&decryption, &encryption);
+                Hill2Candidate candidate;
+                candidate.key.mat[0][0] = encryption.mat[0][0];
+                candidate.key.mat[0][1] = encryption.mat[0][1];
+                candidate.key.mat[1][0] = encryption.mat[1][0];
+                candidate.key.mat[1][1] = encryption.mat[1][1];
+                candidate.score = score;
+                count = insert_hill2_candidate(best, count, k, candidate);
+            }
+        }
+        local_count[id] = count;
+    };
+    run_workers(thread_count, worker); // Le thread appelant participe aussi
+
+    // Fusionne les meilleurs candidats de chaque thread
+    size_t merged = 0;
+    for (unsigned t = 0; t < thread_count; t++) {
+        for (size_t i = 0; i < local_count[t]; i++) {
+            merged = insert_hill2_candidate(top, merged, k, local_top[t * k + i]);
+        }
+    }
+    free(rows);
+    free(local_top);
+    free(local_count);
+    return merged;
+}
+
+// --- 3.5 Attaque de Hill NxN ligne par ligne ---
+
+#define HILL_ROW_ATTACK_MAX_N 5   // 26^5 lignes candidates : au-delà, la recherche est trop longue
+#define HILL_ROW_MAX_BLOCKS 1000  // Nombre de blocs chiffrés utilisés pour noter une ligne
+
+// Ligne candidate de la matrice de déchiffrement, notée par le khi-deux de ses lettres
+typedef struct {
+    int row[HILL_MAX_N];
+    double score; // Khi-deux (plus faible = plus proche de la langue)
+} HillRowCandidate;
+
+/**
+ * @brief Insère une ligne dans une liste triée (khi-deux croissant) de capacité k.
+ * @return Le nouveau nombre d'éléments de la liste.
+ */
+static size_t insert_hill_row_candidate(HillRowCandidate* list, size_t count, size_t k, const HillRowCandidate* candidate) {
+    size_t pos = count < k ? count : k;
+    while (pos > 0 && list[pos - 1].score > candidate->score) {
+        if (pos < k) list[pos] = list[pos - 1];
+        pos--;
+    }
+    if (pos < k) {
+        list[pos] = *candidate;
+        if (count < k) count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Classe toutes les lignes possibles d'une matrice de déchiffrement NxN.
+ *
+ * Une ligne (x_1 ... x_n) de la matrice de déchiffrement produit à elle seule
+ * une lettre par bloc, sum(x_j * c_j) mod 26 : sa qualité se juge sur la
+ * distribution de ce flux, indépendamment des autres lignes. On parcourt donc
+ * 26^n lignes au lieu de 26^(n*n) matrices. Les n - 1 premiers coefficients
+ * sont répartis entre les threads ; pour chacun, le dernier coefficient est
+ * balayé en ajoutant une colonne de texte chiffré au flux précédent, sans
+ * multiplication.
+ *
+ * @param ciphertext Le texte chiffré (majuscules A-Z, longueur multiple de n).
+ * @param n La taille de la matrice (2 <= n <= HILL_ROW_ATTACK_MAX_N).
+ * @param reference Les fréquences de référence de la langue.
+ * @param top Reçoit les meilleures lignes, par khi-deux croissant.
+ * @param k La capacité de 'top'.
+ * @return Le nombre de lignes écrites dans 'top', 0 en cas d'erreur.
+ */
+size_t rank_hill_rows(const char* ciphertext, int n, const double reference[ALPHABET_SIZE],
+                      HillRowCandidate* top, size_t k) {
+    size_t len = strlen(ciphertext);
+    if (n < 2 || n > HILL_ROW_ATTACK_MAX_N || len % n != 0 || len == 0 || k == 0) {
+        fprintf(stderr, "Erreur Hill: Taille de matrice ou longueur du texte chiffré invalide.\n");
+        return 0;
+    }
+    size_t blocks = len / n;
+    if (blocks > HILL_ROW_MAX_BLOCKS) blocks = HILL_ROW_MAX_BLOCKS;
+
+    // Texte chiffré transposé : columns[j * blocks + t] = j-ième lettre du bloc t
+    uint8_t* columns = (uint8_t*)malloc(n * blocks);
+    if (columns == NULL) {
+        perror("Échec d'allocation mémoire");
+        return 0;
+    }
+    for (size_t t = 0; t < blocks; t++) {
+        for (int j = 0; j < n; j++) {
+            unsigned letter = (unsigned)(ciphertext[t * n + j] - 'A');
+            if (letter >= ALPHABET_SIZE) {
+                fprintf(stderr, "Erreur Hill: Caractère non alphabétique dans le texte chiffré.\n");
+                free(columns);
+                return 0;
+            }
+            columns[j * blocks + t] = (uint8_t)letter;
+        }
+    }
+
+    size_t prefixes = 1;
+    for (int j = 1; j < n; j++) prefixes *= ALPHABET_SIZE;
+
+    unsigned thread_count = worker_count(prefixes);
+    HillRowCandidate* local_top = (HillRowCandidate*)malloc(thread_count * k * sizeof(HillRowCandidate));
+    size_t* local_count = (size_t*)calloc(thread_count, sizeof(size_t));
+    uint8_t* streams = (uint8_t*)malloc(thread_count * blocks);
+    if (local_top == NULL || local_count == NULL || streams == NULL) {
+        perror("Échec d'allocation mémoire");
+        free(columns); free(local_top); free(local_count); free(streams);
+        return 0;
+    }
+
+    const uint8_t* last_column = columns + (n - 1) * blocks;
+    std::atomic<size_t> next_prefix(0);
+    auto worker = [&](unsigned id) {
+        HillRowCandidate* best = local_top + id * k;
+        uint8_t* stream = streams + id * blocks;
+        size_t count = 0;
+        HillRowCandidate candidate;
+        memset(&candidate, 0, sizeof(candidate));
+        for (size_t prefix = next_prefix++; prefix < prefixes; prefix = next_prefix++) {
+            // Décompose le préfixe en coefficients x_1 ... x_{n-1}
+            size_t rest = prefix;
+            for (int j = n - 2; j >= 0; j--) {
+                candidate.row[j] = (int)(rest % ALPHABET_SIZE);
+                rest /= ALPHABET_SIZE;
+            }
+            for (size_t t = 0; t < blocks; t++) {
+                int acc = 0;
+                for (int j = 0; j < n - 1; j++) {
+                    acc += candidate.row[j] * columns[j * blocks + t];
+                }
+                stream[t] = (uint8_t)(acc % ALPHABET_SIZE);
+            }
+            // Balaye x_n : chaque incrément ajoute la dernière colonne au flux
+            for (int last = 0; last < ALPHABET_SIZE; last++) {
+                size_t counts[ALPHABET_SIZE] = {0};
+                for (size_t t = 0; t < blocks; t++) {
+                    counts[stream[t]]++;
+                    uint8_t next = (uint8_t)(stream[t] + last_column[t]);
+                    stream[t] = next >= ALPHABET_SIZE ? (uint8_t)(next - ALPHABET_SIZE) : next;
+                }
+                candidate.row[n - 1] = last;
+                candidate.score = chi_squared(counts, blocks, reference);
+                count = insert_hill_row_candidate(best, count, k, &candidate);
+            }
+        }
+        local_count[id] = count;
+    };
+    run_workers(thread_count, worker); // Le thread appelant participe aussi
+
+    // Fusionne les meilleures lignes de chaque thread
+    size_t merged = 0;
+    for (unsigned t = 0; t < thread_count; t++) {
+        for (size_t i = 0; i < local_count[t]; i++) {
+            merged = insert_hill_row_candidate(top, merged, k, &local_top[t * k + i]);
+        }
+    }
+    free(columns);
+    free(local_top);
+    free(local_count);
+    free(streams);
+    return merged;
+}
+
+/**
+ * @brief Casse un chiffrement de Hill NxN à texte chiffré seul, ligne par ligne.
+ *
+ * Les meilleures lignes sont d'abord classées par rank_hill_rows. Comme le
+ * critère ne dit pas à quelle position du bloc une ligne correspond, toutes les
+ * affectations ordonnées de n lignes distinctes parmi les candidates sont
+ * ensuite essayées : chaque matrice inversible est notée par la log-vraisemblance
+ * en bigrammes du clair obtenu, reconstitué à partir des flux déjà calculés.
+ *
+ * @param ciphertext Le texte chiffré (majuscules A-Z, longueur multiple de n).
+ * @param n La taille de la matrice (2 <= n <= HILL_ROW_ATTACK_MAX_N).
+ * @param reference Les fréquences de référence de la langue.
+ * @param model Le modèle de bigrammes de la langue.
+ * @param candidates Le nombre de lignes candidates retenues (0 : 3 * n).
+ * @param key Reçoit la clé de chiffrement retrouvée.
+ * @return 0 en cas de succès, -1 si aucune matrice inversible n'a été trouvée.
+ */
+int crack_hill_rows(const char* ciphertext, int n, const double reference[ALPHABET_SIZE],
+                    const BigramModel* model, size_t candidates, HillMatrix* key) {
+    if (n < 2 || n > HILL_ROW_ATTACK_MAX_N) {
+        fprintf(stderr, "Erreur Hill: Taille de matrice (%d) invalide pour l'attaque ligne par ligne.\n", n);
+        return -1;
+    }
+    if (candidates == 0) candidates = 3 * n;
+    if (candidates < (size_t)n) candidates = n;
+    HillRowCandidate* rows = (HillRowCandidate*)malloc(candidates * sizeof(HillRowCandidate));
+    if (rows == NULL) {
+        perror("Échec d'allocation mémoire");
+        return -1;
+    }
+    size_t found = rank_hill_rows(ciphertext, n, reference, rows, candidates);
+    if (found < (size_t)n) {
+        free(rows);
+        return -1;
+    }
+
+    // Flux de clair produit par chaque ligne candidate
+    size_t blocks = strlen(ciphertext) / n;
+    if (blocks > HILL_ROW_MAX_BLOCKS) blocks = HILL_ROW_MAX_BLOCKS;
+    uint8_t* streams = (uint8_t*)malloc(found * blocks);
+    if (streams == NULL) {
+        perror("Échec d'allocation mémoire");
+        free(rows);
+        return -1;
+    }
+    for (size_t r = 0; r < found; r++) {
+        for (size_t t = 0; t < blocks; t++) {
+            int acc = 0;
+            for (int j = 0; j < n; j++) {
+                acc += rows[r].row[j] * (ciphertext[t * n + j] - 'A');
+            }
+            streams[r * blocks + t] = (uint8_t)(acc % ALPHABET_SIZE);
+        }
+    }
+
+    // Parcourt les affectations (ligne candidate -> position) comme un compteur en base 'found'
+    size_t choice[HILL_ROW_ATTACK_MAX_N] = {0};
+    double best_score = -INFINITY;
+    while (1) {
+        int distinct = 1;
+        for (int i = 0; i < n && distinct; i++) {
+            for (int j = 0; j < i; j++) {
+                if (choice[i] == choice[j]) { distinct = 0; break; }
+            }
+        }
+        if (distinct) {
+            HillMatrix candidate, inverse;
+            candidate.n = n;
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) candidate.mat[i][j] = rows[choice[i]].row[j];
+            }
+            if (invert_hill_matrix(&candidate, &inverse) == 0) {
+                // Clair = flux des lignes choisies entrelacés bloc par bloc
+                double score = 0.0;
+                int previous = -1;
+                for (size_t t = 0; t < blocks; t++) {
+                    for (int i = 0; i < n; i++) {
+                        int letter = streams[choice[i] * blocks + t];
+                        if (previous >= 0) score += model->logp[previous][letter];
+                        previous = letter;
+                    }
+                }
+                if (score > best_score) {
+                    best_score = score;
+                    *key = inverse;
+                }
+            }
+        }
+
+        int pos = n - 1;
+        while (pos >= 0 && ++choice[pos] == found) {
+            choice[pos--] = 0;
+        }
+        if (pos < 0) break;
+    }
+    free(rows);
+    free(streams);
+    return best_score == -INFINITY ? -1 : 0;
+}
+
+// --- 3.6 Modèle de quadrigrammes projeté en mémoire ---
+
+#define QUADGRAM_COUNT (ALPHABET_SIZE * ALPHABET_SIZE * ALPHABET_SIZE * ALPHABET_SIZE) // 26^4
+#define TRIGRAM_COUNT (ALPHABET_SIZE * ALPHABET_SIZE * ALPHABET_SIZE)
+#define QUADGRAM_MAGIC "QUADGR01"
+
+// En-tête du fichier binaire, suivi de QUADGRAM_COUNT valeurs uint16_t.
+// Une valeur q représente la log-probabilité -q / scale.
+typedef struct {
+    char magic[8];
+    float scale;
+    uint32_t count;
+} QuadgramFileHeader;
+
+// Modèle de quadrigrammes : table quantifiée, soit projetée depuis un fichier, soit allouée
+typedef struct {
+    const uint16_t* table; // Pénalités quantifiées, indexées par a*26^3 + b*26^2 + c*26 + d
+    float scale;           // Facteur de quantification
+    void* mapping;         // Zone projetée par mmap (NULL si le modèle a été construit en mémoire)
+    size_t mapping_size;
+} QuadgramModel;
+
+/**
+ * @brief Compte les quadrigrammes d'un morceau de corpus.
+ * L'index glissant et le nombre de lettres lues sont conservés d'un appel à
+ * l'autre, un corpus lu par tampons est donc compté comme un texte continu.
+ * @return Le nombre de quadrigrammes comptés dans ce morceau.
+ */
+static size_t count_quadgrams(const char* text, size_t len, uint32_t* counts, uint32_t* index, size_t* letters) {
+    size_t total = 0;
+    for (size_t i = 0; i < len; i++) {
+        unsigned letter = ((unsigned char)text[i] | 0x20) - 'a';
+        if (letter >= ALPHABET_SIZE) continue;
+        *index = (*index % TRIGRAM_COUNT) * ALPHABET_SIZE + letter;
+        if (++*letters >= 4) {
+            counts[*index]++;
+            total++;
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Quantifie les log-probabilités sur 16 bits (lissage : un quadrigramme
+ * absent vaut 0,01 occurrence), la plus faible correspondant à 65535.
+ * @return Le facteur de quantification.
+ */
+static float quantize_quadgrams(const uint32_t* counts, size_t total, uint16_t* table) {
+    double floor_logp = log(0.01 / (total + 1));
+    float scale = (float)(65535.0 / -floor_logp);
+    for (size_t q = 0; q < QUADGRAM_COUNT; q++) {
+        double logp = counts[q] ? log((double)counts[q] / total) : floor_logp;
+        table[q] = (uint16_t)lround(-logp * scale);
+    }
+    return scale;
+}
+
+/**
+ * @brief Construit un modèle de quadrigrammes à partir d'un corpus en mémoire.
+ * @param corpus Le texte de référence.
+ * @param len Le nombre d'octets du corpus.
+ * @param model Le modèle à remplir (à libérer avec free_quadgram_model).
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int build_quadgram_model(const char* corpus, size_t len, QuadgramModel* model) {
+    uint32_t* counts = (uint32_t*)calloc(QUADGRAM_COUNT, sizeof(uint32_t));
+    uint16_t* table = (uint16_t*)malloc(QUADGRAM_COUNT * sizeof(uint16_t));
+    if (counts == NULL || table == NULL) {
+        perror("Échec d'allocation mémoire");
+        free(counts);
+        free(table);
+        return -1;
+    }
+
+    uint32_t index = 0;
+    size_t letters = 0;
+    size_t total = count_quadgrams(corpus, len, counts, &index, &letters);
+    float scale = quantize_quadgrams(counts, total, table);
+    free(counts);
+
+    model->table = table;
+    model->scale = scale;
+    model->mapping = NULL;
+    model->mapping_size = 0;
+    return 0;
+}
+
+/**
+ * @brief Enregistre un modèle de quadrigrammes dans un fichier binaire projetable.
+ * @param model Le modèle à enregistrer.
+ * @param path Le chemin du fichier.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int save_quadgram_model(const QuadgramModel* model, const char* path) {
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        perror("Erreur d'ouverture du fichier");
+        return -1;
+    }
+    QuadgramFileHeader header;
+    memcpy(header.magic, QUADGRAM_MAGIC, sizeof(header.magic));
+    header.scale = model->scale;
+    header.count = QUADGRAM_COUNT;
+    if (fwrite(&header, sizeof(header), 1, file) != 1 ||
+        fwrite(model->table, sizeof(uint16_t), QUADGRAM_COUNT, file) != QUADGRAM_COUNT) {
+        perror("Erreur d'écriture du fichier");
+        fclose(file);
+        return -1;
+    }
+    if (fclose(file) != 0) {
+        perror("Erreur d'écriture du fichier");
+        return -1;
+    }
+    return 0;
+}
 
-    printf("Texte: \"%s\"\n", text_chiffre_aleatoire);
-    printf("  Entropie: %.4f bits/char\n", calculate_entropy(text_chiffre_aleatoire));
-    printf("  Redondance: %.4f bits/char\n", calculate_redundancy(text_chiffre_aleatoire));
-    printf("  Incidence de coïncidence: %.4f\n\n", calculate_ic(text_chiffre_aleatoire));
+/**
+ * @brief Génère une table de quadrigrammes à partir d'un fichier corpus.
+ * Le corpus est lu par tampons (mémoire constante hors table), ce qui permet
+ * de produire les tables française et anglaise à partir de textes réels de
+ * plusieurs mégaoctets. Les lettres accentuées sont ignorées : fournir de
+ * préférence un corpus désaccentué.
+ * @param corpus_path Le chemin du corpus.
+ * @param output_path Le chemin du fichier binaire à produire.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int build_quadgram_file(const char* corpus_path, const char* output_path) {
+    int fd = open(corpus_path, O_RDONLY);
+    if (fd == -1) {
+        perror("Erreur d'ouverture du corpus");
+        return -1;
+    }
+    uint32_t* counts = (uint32_t*)calloc(QUADGRAM_COUNT, sizeof(uint32_t));
+    uint16_t* table = (uint16_t*)malloc(QUADGRAM_COUNT * sizeof(uint16_t));
+    if (counts == NULL || table == NULL) {
+        perror("Échec d'allocation mémoire");
+        free(counts);
+        free(table);
+        close(fd);
+        return -1;
+    }
+
+    char buffer[STREAM_BUFFER_SIZE];
+    size_t total = 0;
+    uint32_t index = 0;
+    size_t letters = 0;
+    for (;;) {
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("Erreur de lecture");
+            free(counts);
+            free(table);
+            close(fd);
+            return -1;
+        }
+        if (n == 0) break; // Fin du corpus
+        total += count_quadgrams(buffer, (size_t)n, counts, &index, &letters);
+    }
+    close(fd);
+    if (total == 0) {
+        fprintf(stderr, "Erreur quadrigrammes: Le corpus ne contient aucun quadrigramme.\n");
+        free(counts);
+        free(table);
+        return -1;
+    }
+
+    QuadgramModel model;
+    model.table = table;
+    model.scale = quantize_quadgrams(counts, total, table);
+    model.mapping = NULL;
+    model.mapping_size = 0;
+    free(counts);
+    int result = save_quadgram_model(&model, output_path);
+    free(table);
+    return result;
+}
+
+/**
+ * @brief Charge un modèle de quadrigrammes en projetant le fichier en mémoire.
+ * Aucune analyse n'est faite : les pages sont lues à la demande par le système,
+ * le chargement est donc quasi instantané.
+ * @param path Le chemin du fichier (produit par save_quadgram_model).
+ * @param model Le modèle à remplir (à libérer avec free_quadgram_model).
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int load_quadgram_model(const char* path, QuadgramModel* model) {
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        perror("Erreur d'ouverture du fichier");
+        return -1;
+    }
+    struct stat st;
+    size_t expected = sizeof(QuadgramFileHeader) + QUADGRAM_COUNT * sizeof(uint16_t);
+    if (fstat(fd, &st) == -1 || (size_t)st.st_size != expected) {
+        fprintf(stderr, "Erreur quadrigrammes: Taille de fichier invalide.\n");
+        close(fd);
+        return -1;
+    }
+    void* mapping = mmap(NULL, expected, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // La projection reste valide après la fermeture
+    if (mapping == MAP_FAILED) {
+        perror("Erreur de projection du fichier");
+        return -1;
+    }
+
+    const QuadgramFileHeader* header = (const QuadgramFileHeader*)mapping;
+    if (memcmp(header->magic, QUADGRAM_MAGIC, sizeof(header->magic)) != 0 ||
+        header->count != QUADGRAM_COUNT || !(header->scale > 0.0f)) {
+        fprintf(stderr, "Erreur quadrigrammes: En-tête de fichier invalide.\n");
+        munmap(mapping, expected);
+        return -1;
+    }
+    model->table = (const uint16_t*)((const char*)mapping + sizeof(QuadgramFileHeader));
+    model->scale = header->scale;
+    model->mapping = mapping;
+    model->mapping_size = expected;
+    return 0;
+}
+
+/**
+ * @brief Libère un modèle de quadrigrammes (projeté ou construit en mémoire).
+ */
+void free_quadgram_model(QuadgramModel* model) {
+    if (model->mapping != NULL) {
+        munmap(model->mapping, model->mapping_size);
+    } else {
+        free((void*)model->table);
+    }
+    model->table = NULL;
+    model->mapping = NULL;
+    model->mapping_size = 0;
+}
+
+/**
+ * @brief Note un texte par la log-vraisemblance de ses quadrigrammes.
+ * L'index du quadrigramme courant est mis à jour à chaque lettre (on retire la
+ * plus ancienne, on ajoute la nouvelle) ; les pénalités entières sont cumulées
+ * et converties une seule fois à la fin. Les non-lettres sont ignorées.
+ * @param model Le modèle de quadrigrammes.
+ * @param text Le texte à noter.
+ * @param len Le nombre d'octets du texte.
+ * @return La log-vraisemblance (plus élevée = plus proche de la langue).
+ */
+double score_quadgrams(const QuadgramModel* model, const char* text, size_t len) {
+    const uint16_t* table = model->table;
+    uint64_t penalty = 0;
+    uint32_t index = 0;
+    size_t letters = 0;
+    for (size_t i = 0; i < len; i++) {
+        unsigned letter = ((unsigned char)text[i] | 0x20) - 'a';
+        if (letter >= ALPHABET_SIZE) continue;
+        index = (index % TRIGRAM_COUNT) * ALPHABET_SIZE + letter;
+        if (++letters >= 4) penalty += table[index];
+    }
+    return -(double)penalty / model->scale;
+}
+
+// --- 3.7 Substitution monoalphabétique par recuit simulé ---
+
+#define SUBSTITUTION_ITERATIONS 20000 // Échanges essayés par redémarrage
+#define SUBSTITUTION_START_TEMPERATURE 10.0 // Températures du recuit (en unités de log-probabilité)
+#define SUBSTITUTION_FINAL_TEMPERATURE 0.01
+
+// Résultat du cassage d'une substitution monoalphabétique
+typedef struct {
+    char key[ALPHABET_SIZE + 1]; // Clé de chiffrement : key[p] est l'image de la lettre 'A' + p
+    double score;                // Log-vraisemblance en quadrigrammes du clair retrouvé
+} SubstitutionCrackResult;
+
+/**
+ * @brief Générateur pseudo-aléatoire xorshift64, un état par thread.
+ */
+static inline uint64_t xorshift64(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+/**
+ * @brief Un redémarrage du recuit simulé sur la suite de lettres chiffrées.
+ *
+ * decrypt[c] donne la lettre claire de la lettre chiffrée c. Échanger
+ * decrypt[x] et decrypt[y] ne modifie le clair qu'aux positions des lettres x
+ * et y : seuls les quadrigrammes qui les recouvrent sont renotés, retrouvés
+ * grâce à l'index des positions de chaque lettre.
+ *
+ * @return La pénalité totale (somme des valeurs quantifiées) de la clé finale.
+ */
+static uint64_t anneal_substitution(const QuadgramModel* model, const uint8_t* cipher, size_t n,
+                                    const uint32_t* positions, const uint32_t* starts,
+                                    uint64_t seed, uint8_t decrypt[ALPHABET_SIZE],
+                                    uint8_t* plain, uint32_t* touched, uint32_t* stamps) {
+    const uint16_t* table = model->table;
+    uint64_t rng = seed * 0x9E3779B97F4A7C15ull + 1;
+
+    // Clé initiale aléatoire (mélange de Fisher-Yates)
+    for (int l = 0; l < ALPHABET_SIZE; l++) decrypt[l] = (uint8_t)l;
+    for (int l = ALPHABET_SIZE - 1; l > 0; l--) {
+        int j = (int)(xorshift64(&rng) % (l + 1));
+        uint8_t tmp = decrypt[l]; decrypt[l] = decrypt[j]; decrypt[j] = tmp;
+    }
+    for (size_t i = 0; i < n; i++) plain[i] = decrypt[cipher[i]];
+
+    #define QUADGRAM_AT(s) table[((plain[s] * ALPHABET_SIZE + plain[(s) + 1]) * ALPHABET_SIZE + plain[(s) + 2]) * ALPHABET_SIZE + plain[(s) + 3]]
+    size_t quads = n - 3;
+    uint64_t penalty = 0;
+    for (size_t s = 0; s < quads; s++) penalty += QUADGRAM_AT(s);
+
+    uint64_t best_penalty = penalty;
+    uint8_t best[ALPHABET_SIZE];
+    memcpy(best, decrypt, ALPHABET_SIZE);
+    uint32_t stamp = 0;
+    memset(stamps, 0, quads * sizeof(uint32_t));
+
+    // Température en unités de pénalité quantifiée, décroissance géométrique
+    double temperature = SUBSTITUTION_START_TEMPERATURE * model->scale;
+    double cooling = pow(SUBSTITUTION_FINAL_TEMPERATURE / SUBSTITUTION_START_TEMPERATURE, 1.0 / SUBSTITUTION_ITERATIONS);
+    for (int iter = 0; iter < SUBSTITUTION_ITERATIONS; iter++, temperature *= cooling) {
+        int x = (int)(xorshift64(&rng) % ALPHABET_SIZE);
+        int y = (int)(xorshift64(&rng) % (ALPHABET_SIZE - 1));
+        if (y >= x) y++;
+        if (starts[x] == starts[x + 1] && starts[y] == starts[y + 1]) continue; // Lettres absentes
+
+        // Quadrigrammes recouvrant une position de x ou de y (sans doublon)
+        size_t count = 0;
+        if (++stamp == 0) {
+            memset(stamps, 0, quads * sizeof(uint32_t));
+            stamp = 1;
+        }
+        for (int side = 0; side < 2; side++) {
+            int letter = side ? y : x;
+            for (uint32_t k = starts[letter]; k < starts[letter + 1]; k++) {
+                size_t p = positions[k];
+                size_t first = p >= 3 ? p - 3 : 0;
+                size_t last = p < quads ? p : quads - 1;
+                for (size_t s = first; s <= last; s++) {
+                    if (stamps[s] != stamp) {
+                        stamps[s] = stamp;
+                        touched[count++] = (uint32_t)s;
+                    }
+                }
+            }
+        }
+
+        uint64_t before = 0, after = 0;
+        for (size_t k = 0; k < count; k++) before += QUADGRAM_AT(touched[k]);
+        uint8_t px = decrypt[x], py = decrypt[y];
+        for (uint32_t k = starts[x]; k < starts[x + 1]; k++) plain[positions[k]] = py;
+        for (uint32_t k = starts[y]; k < starts[y + 1]; k++) plain[positions[k]] = px;
+        for (size_t k = 0; k < count; k++) after += QUADGRAM_AT(touched[k]);
+
+        // Critère de Metropolis : une dégradation est acceptée avec probabilité exp(-delta / T)
+        double delta = (double)after - (double)before;
+        double u = (xorshift64(&rng) >> 11) * (1.0 / 9007199254740992.0);
+        if (delta <= 0 || u < exp(-delta / temperature)) {
+            decrypt[x] = py;
+            decrypt[y] = px;
+            penalty = penalty + after - before;
+            if (penalty < best_penalty) {
+                best_penalty = penalty;
+                memcpy(best, decrypt, ALPHABET_SIZE);
+            }
+        } else {
+            for (uint32_t k = starts[x]; k < starts[x + 1]; k++) plain[positions[k]] = px;
+            for (uint32_t k = starts[y]; k < starts[y + 1]; k++) plain[positions[k]] = py;
+        }
+    }
+    #undef QUADGRAM_AT
+
+    memcpy(decrypt, best, ALPHABET_SIZE);
+    return best_penalty;
+}
+
+/**
+ * @brief Casse une substitution monoalphabétique quelconque par recuit simulé.
+ *
+ * Chaque redémarrage part d'une clé aléatoire et échange deux lettres de la
+ * clé à chaque pas, en ne renotant que les quadrigrammes touchés. Les
+ * redémarrages indépendants sont répartis entre les threads et la meilleure
+ * clé est conservée.
+ *
+ * @param ciphertext Le texte chiffré (les non-lettres sont ignorées).
+ * @param len Le nombre d'octets du texte chiffré.
+ * @param model Le modèle de quadrigrammes de la langue.
+ * @param restarts Le nombre de redémarrages (0 : 8).
+ * @param result Reçoit la meilleure clé trouvée.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int crack_substitution(const char* ciphertext, size_t len, const QuadgramModel* model,
+                       int restarts, SubstitutionCrackResult* result) {
+    if (restarts <= 0) restarts = 8;
+
+    // Suite des lettres chiffrées et index des positions de chaque lettre
+    uint8_t* cipher = (uint8_t*)malloc(len + 1);
+    uint32_t* positions = (uint32_t*)malloc((len + 1) * sizeof(uint32_t));
+    if (cipher == NULL || positions == NULL) {
+        perror("Échec d'allocation mémoire");
+        free(cipher); free(positions);
+        return -1;
+    }
+    size_t n = 0;
+    for (size_t i = 0; i < len; i++) {
+        unsigned letter = ((unsigned char)ciphertext[i] | 0x20) - 'a';
+        if (letter < ALPHABET_SIZE) cipher[n++] = (uint8_t)letter;
+    }
+    if (n < 4) {
+        fprintf(stderr, "Erreur substitution: Texte chiffré trop court.\n");
+        free(cipher); free(positions);
+        return -1;
+    }
+    uint32_t starts[ALPHABET_SIZE + 1] = {0};
+    for (size_t i = 0; i < n; i++) starts[cipher[i] + 1]++;
+    for (int l = 0; l < ALPHABET_SIZE; l++) starts[l + 1] += starts[l];
+    uint32_t fill[ALPHABET_SIZE];
+    memcpy(fill, starts, sizeof(fill));
+    for (size_t i = 0; i < n; i++) positions[fill[cipher[i]]++] = (uint32_t)i;
+
+    unsigned thread_count = worker_count(restarts);
+    // Tampons de travail par thread : clair courant, quadrigrammes touchés, marqueurs
+    uint8_t* plains = (uint8_t*)malloc(thread_count * n);
+    uint32_t* touched = (uint32_t*)malloc(thread_count * n * sizeof(uint32_t));
+    uint32_t* stamps = (uint32_t*)malloc(thread_count * n * sizeof(uint32_t));
+    uint64_t* local_penalty = (uint64_t*)malloc(thread_count * sizeof(uint64_t));
+    uint8_t* local_key = (uint8_t*)malloc(thread_count * ALPHABET_SIZE);
+    if (plains == NULL || touched == NULL || stamps == NULL || local_penalty == NULL || local_key == NULL) {
+        perror("Échec d'allocation mémoire");
+        free(cipher); free(positions); free(plains); free(touched); free(stamps);
+        free(local_penalty); free(local_key);
+        return -1;
+    }
+
+    std::atomic<int> next_restart(0);
+    auto worker = [&](unsigned id) {
+        local_penalty[id] = UINT64_MAX;
+        uint8_t decrypt[ALPHABET_SIZE];
+        for (int r = next_restart++; r < restarts; r = next_restart++) {
+            uint64_t penalty = anneal_substitution(model, cipher, n, positions, starts, (uint64_t)r + 1, decrypt,
+                                                   plains + id * n, touched + id * n, stamps + id * n);
+            if (penalty < local_penalty[id]) {
+                local_penalty[id] = penalty;
+                memcpy(local_key + id * ALPHABET_SIZE, decrypt, ALPHABET_SIZE);
+            }
+        }
+    };
+    run_workers(thread_count, worker); // Le thread appelant participe aussi
 
-    printf("Texte: \"%s\"\n", text_redondant);
-    printf("  Entropie: %.4f bits/char\n", calculate_entropy(text_redondant));
-    printf("  Redondance: %.4f bits/char\n", calculate_redundancy(text_redondant));
-    printf("  Incidence de coïncidence: %.4f\n\n", calculate_ic(text_redondant));
+    unsigned best = 0;
+    for (unsigned t = 1; t < thread_count; t++) {
+        if (local_penalty[t] < local_penalty[best]) best = t;
+    }
+    // La clé de déchiffrement est inversée en clé de chiffrement
+    const uint8_t* decrypt = local_key + best * ALPHABET_SIZE;
+    for (int c = 0; c < ALPHABET_SIZE; c++) {
+        result->key[decrypt[c]] = (char)('A' + c);
+    }
+    result->key[ALPHABET_SIZE] = '\0';
+    result->score = -(double)local_penalty[best] / model->scale;
+
+    free(cipher); free(positions); free(plains); free(touched); free(stamps);
+    free(local_penalty); free(local_key);
+    return 0;
+}
+
+// --- Fonction main pour démontrer toutes les fonctionnalités ---
+// Usage :
+//   ./aes                                        démonstration complète
+//   ./aes quadgrammes_fr.bin                     démonstration avec une table de quadrigrammes réelle
+//   ./aes --quadgrammes corpus.txt sortie.bin    génération d'une table (française, anglaise...)
+int main(int argc, char* argv[]) {
+    if (argc == 4 && strcmp(argv[1], "--quadgrammes") == 0) {
+        if (build_quadgram_file(argv[2], argv[3]) == -1) {
+            return 1;
+        }
+        printf("Table de quadrigrammes écrite dans \"%s\"\n", argv[3]);
+        return 0;
+    }
+    const char* quadgram_table_path = argc == 2 ? argv[1] : NULL;
+
+    // --- Tests pour Entropie, Redondance, Incidence de Coïncidence ---
+    const char* text_clair = "CECI EST UN TEST POUR LENTROPIE ET LA REDONDANCE ET LINCIDENCE DE COINCIDENCE";
+    const char* text_chiffre_aleatoire = "ZQWXTJKLMNOIPQRSUVWXZYZABCDEFGH"; // Exemple de texte "aléatoire"
+    const char* text_redondant = "AAAAAAAAAAAAAAAAAAAAAAAAAAAZZAAAAAAAAAAAAAAAAA";
+
+    printf("--- Entropie, Redondance et Incidence de Coïncidence ---\n");
+    // Un seul parcours par texte : les trois mesures sont dérivées du même profil
+    const char* profile_texts[] = { text_clair, text_chiffre_aleatoire, text_redondant };
+    for (int t = 0; t < 3; t++) {
+        TextProfile profile;
+        build_text_profile(profile_texts[t], strlen(profile_texts[t]), &profile);
+        printf("Texte: \"%s\"\n", profile_texts[t]);
+        printf("  Entropie: %.4f bits/char\n", profile_entropy(&profile));
+        printf("  Redondance: %.4f bits/char\n", profile_redundancy(&profile));
+        printf("  Incidence de coïncidence: %.4f\n\n", profile_ic(&profile));
+    }
 
 
     // --- Tests pour Chiffrement de Lester Hill (matrice 2x2) ---
@@ -363,8 +2614,53 @@ int main() {
             printf("Message déchiffré : \"%s\"\n", decrypted_hill);
             free(decrypted_hill);
         }
+
+        // Attaque à clair connu : la clé se déduit du couple clair/chiffré
+        Matrix2x2 recovered_key;
+        if (solve_hill_known_plaintext(hill_message, encrypted_hill, strlen(encrypted_hill), &recovered_key) == 0) {
+            printf("Clé retrouvée (clair connu) : [%d %d] [%d %d]\n", recovered_key.mat[0][0], recovered_key.mat[0][1],
+                   recovered_key.mat[1][0], recovered_key.mat[1][1]);
+        }
         free(encrypted_hill);
     }
+
+    // Mot probable : seul un mot du clair est connu, pas sa position
+    const char* hill_crib = "cryptographie";
+    char* encrypted_reference_hill = encrypt_hill(FRENCH_REFERENCE_TEXT, hill_key);
+    if (encrypted_reference_hill != NULL) {
+        HillCribMatch crib_matches[3];
+        size_t crib_found = search_hill_crib(encrypted_reference_hill, hill_crib, FRENCH_FREQUENCIES, crib_matches, 3);
+        printf("Mot probable \"%s\" : %zu position(s) cohérente(s)\n", hill_crib, crib_found);
+        for (size_t i = 0; i < crib_found; i++) {
+            printf("  Position %4zu : clé [%d %d] [%d %d], khi-deux = %.2f\n", crib_matches[i].offset,
+                   crib_matches[i].key.mat[0][0], crib_matches[i].key.mat[0][1],
+                   crib_matches[i].key.mat[1][0], crib_matches[i].key.mat[1][1], crib_matches[i].score);
+        }
+        // Un mot sans lettres ne fournit aucun digramme
+        printf("Mot probable \"1234\" : %zu position(s)\n",
+               search_hill_crib(encrypted_reference_hill, "1234", FRENCH_FREQUENCIES, crib_matches, 3));
+        free(encrypted_reference_hill);
+    }
+    printf("\n");
+
+    // --- Tests pour Chiffrement de Hill généralisé (matrice 3x3) ---
+    HillMatrix hill3_key = {3, {{6, 24, 1}, {13, 16, 10}, {20, 17, 15}}};
+    const char* hill3_message = "ACTIONDEMAIN";
+
+    printf("\n--- Chiffrement de Hill généralisé (Matrice 3x3) ---\n");
+    printf("Message original : \"%s\"\n", hill3_message);
+
+    char* encrypted_hill3 = encrypt_hill(hill3_message, &hill3_key);
+    if (encrypted_hill3 != NULL) {
+        printf("Message chiffré : \"%s\"\n", encrypted_hill3);
+
+        char* decrypted_hill3 = decrypt_hill(encrypted_hill3, &hill3_key);
+        if (decrypted_hill3 != NULL) {
+            printf("Message déchiffré : \"%s\"\n", decrypted_hill3);
+            free(decrypted_hill3);
+        }
+        free(encrypted_hill3);
+    }
     printf("\n");
 
     // --- Tests pour Chiffrement Affine ---
@@ -387,6 +2683,183 @@ int main() {
         }
         free(encrypted_affine);
     }
+
+    // Traitement par lots : plusieurs messages d'une même arène, chacun avec sa clé
+    char affine_arena[] = "CRYPTOGRAPHIE" "EST" "AMUSANTE";
+    AffineRecord affine_records[] = {{0, 13, 5, 8}, {13, 3, 7, 3}, {16, 8, 25, 0}};
+    size_t affine_record_count = sizeof(affine_records) / sizeof(affine_records[0]);
+    if (encrypt_affine_batch(affine_arena, affine_arena, affine_records, affine_record_count, 0) == 0) {
+        printf("Lot chiffré : \"%s\"\n", affine_arena);
+        if (encrypt_affine_batch(affine_arena, affine_arena, affine_records, affine_record_count, 1) == 0) {
+            printf("Lot déchiffré : \"%s\"\n", affine_arena);
+        }
+    }
+    printf("\n");
+
+    // --- Tests pour la cryptanalyse de César ---
+    const char* cesar_message = "LA CRYPTOGRAPHIE EST L'ART DE PROTEGER DES MESSAGES EN LES RENDANT "
+                                "INCOMPREHENSIBLES A TOUTE PERSONNE QUI NE POSSEDE PAS LA CLE SECRETE";
+    int cesar_shift = 11;
+
+    printf("\n--- Cryptanalyse de César (khi-deux) ---\n");
+    // César est le chiffrement affine de clé a = 1
+    char* encrypted_cesar = encrypt_affine(cesar_message, 1, cesar_shift);
+    if (encrypted_cesar != NULL) {
+        printf("Message chiffré (décalage %d) : \"%s\"\n", cesar_shift, encrypted_cesar);
+
+        CesarCandidate cesar_ranking[ALPHABET_SIZE];
+        crack_cesar(encrypted_cesar, strlen(encrypted_cesar), FRENCH_FREQUENCIES, cesar_ranking);
+        for (int i = 0; i < 3; i++) {
+            printf("  Décalage %2d : khi-deux = %.2f\n", cesar_ranking[i].shift, cesar_ranking[i].score);
+        }
+
+        // Le même texte chiffré classé selon les deux profils : le khi-deux le plus faible désigne la langue
+        CesarCandidate english_ranking[ALPHABET_SIZE];
+        crack_cesar(encrypted_cesar, strlen(encrypted_cesar), ENGLISH_FREQUENCIES, english_ranking);
+        printf("Profil français : décalage %2d, khi-deux = %.2f\n", cesar_ranking[0].shift, cesar_ranking[0].score);
+        printf("Profil anglais  : décalage %2d, khi-deux = %.2f\n", english_ranking[0].shift, english_ranking[0].score);
+        printf("Langue la plus probable : %s\n", cesar_ranking[0].score <= english_ranking[0].score ? "français" : "anglais");
+        free(encrypted_cesar);
+    }
+    printf("\n");
+
+    // --- Tests pour la cryptanalyse affine ---
+    printf("\n--- Cryptanalyse affine (312 clés) ---\n");
+    char* encrypted_long_affine = encrypt_affine(cesar_message, a_key, b_key);
+    if (encrypted_long_affine != NULL) {
+        AffineCandidate affine_ranking[3];
+        size_t found = crack_affine(encrypted_long_affine, strlen(encrypted_long_affine), FRENCH_FREQUENCIES,
+                                    SCORE_LOG_LIKELIHOOD, affine_ranking, 3);
+        for (size_t i = 0; i < found; i++) {
+            printf("  a = %2d, b = %2d : log-vraisemblance = %.2f\n",
+                   affine_ranking[i].a, affine_ranking[i].b, affine_ranking[i].score);
+        }
+        free(encrypted_long_affine);
+    }
+    printf("\n");
+
+    // --- Tests pour la recherche exhaustive Hill 2x2 ---
+    printf("\n--- Recherche exhaustive Hill 2x2 (bigrammes) ---\n");
+    BigramModel french_bigrams;
+    build_bigram_model(FRENCH_REFERENCE_TEXT, strlen(FRENCH_REFERENCE_TEXT), &french_bigrams);
+    Matrix2x2 secret_hill = {{{5, 17}, {4, 15}}};
+    char* encrypted_secret_hill = encrypt_hill(cesar_message, secret_hill);
+    if (encrypted_secret_hill != NULL) {
+        Hill2Candidate hill_ranking[3];
+        size_t found = crack_hill2(encrypted_secret_hill, &french_bigrams, 0, hill_ranking, 3);
+        for (size_t i = 0; i < found; i++) {
+            printf("  Clé [[%2d, %2d], [%2d, %2d]] : log-vraisemblance = %.2f\n",
+                   hill_ranking[i].key.mat[0][0], hill_ranking[i].key.mat[0][1],
+                   hill_ranking[i].key.mat[1][0], hill_ranking[i].key.mat[1][1], hill_ranking[i].score);
+        }
+        free(encrypted_secret_hill);
+    }
+    printf("\n");
+
+    // --- Tests pour l'attaque de Hill NxN ligne par ligne ---
+    printf("\n--- Attaque de Hill 3x3 ligne par ligne ---\n");
+    HillMatrix secret_hill3 = {3, {{6, 24, 1}, {13, 16, 10}, {20, 17, 15}}};
+    char* encrypted_reference = encrypt_hill(FRENCH_REFERENCE_TEXT, &secret_hill3);
+    if (encrypted_reference != NULL) {
+        HillMatrix recovered_hill3;
+        if (crack_hill_rows(encrypted_reference, 3, FRENCH_FREQUENCIES, &french_bigrams, 0, &recovered_hill3) == 0) {
+            printf("Clé retrouvée :\n");
+            for (int r = 0; r < recovered_hill3.n; r++) {
+                printf("  [%2d, %2d, %2d]\n", recovered_hill3.mat[r][0], recovered_hill3.mat[r][1], recovered_hill3.mat[r][2]);
+            }
+        }
+        free(encrypted_reference);
+    }
+    printf("\n");
+
+    // --- Tests pour le modèle de quadrigrammes ---
+    printf("\n--- Modèle de quadrigrammes ---\n");
+    QuadgramModel french_quadgrams;
+    int quadgrams_loaded = 0;
+    if (quadgram_table_path != NULL) {
+        if (load_quadgram_model(quadgram_table_path, &french_quadgrams) == 0) {
+            printf("Table projetée depuis \"%s\"\n", quadgram_table_path);
+            quadgrams_loaded = 1;
+        }
+    } else {
+        // Sans table réelle, un modèle de démonstration est tiré du texte de référence
+        // intégré (trop court pour servir de modèle de langue) et projeté depuis un
+        // fichier temporaire.
+        const char* tmp_dir = getenv("TMPDIR");
+        char tmp_path[4096];
+        snprintf(tmp_path, sizeof(tmp_path), "%s/quadgrammes_XXXXXX", tmp_dir != NULL && *tmp_dir ? tmp_dir : "/tmp");
+        int tmp_fd = mkstemp(tmp_path);
+        if (tmp_fd == -1) {
+            perror("Erreur de création du fichier temporaire");
+        } else {
+            close(tmp_fd);
+            if (build_quadgram_model(FRENCH_REFERENCE_TEXT, strlen(FRENCH_REFERENCE_TEXT), &french_quadgrams) == 0) {
+                int saved = save_quadgram_model(&french_quadgrams, tmp_path);
+                free_quadgram_model(&french_quadgrams);
+                if (saved == 0 && load_quadgram_model(tmp_path, &french_quadgrams) == 0) {
+                    printf("Modèle de démonstration (texte de référence, %zu octets) projeté depuis \"%s\"\n",
+                           strlen(FRENCH_REFERENCE_TEXT), tmp_path);
+                    printf("(générer une vraie table : ./aes --quadgrammes corpus_fr.txt quadgrammes_fr.bin)\n");
+                    quadgrams_loaded = 1;
+                }
+            }
+            unlink(tmp_path); // La projection reste valide après la suppression
+        }
+    }
+    if (quadgrams_loaded) {
+        char* shifted = encrypt_affine(cesar_message, 1, cesar_shift);
+        if (shifted != NULL) {
+            printf("  Clair   : %.2f\n", score_quadgrams(&french_quadgrams, cesar_message, strlen(cesar_message)));
+            printf("  Chiffré : %.2f\n", score_quadgrams(&french_quadgrams, shifted, strlen(shifted)));
+            free(shifted);
+        }
+    }
+    printf("\n");
+
+    // --- Tests pour le cassage de substitution par recuit simulé ---
+    printf("\n--- Substitution monoalphabétique (recuit simulé) ---\n");
+    SubstitutionTable secret_substitution;
+    if (quadgrams_loaded) {
+        // Texte absent du corpus d'apprentissage du modèle
+        const char* held_out_message =
+            "Pendant la seconde guerre mondiale, les armees allemandes utilisaient une machine "
+            "electromecanique appelee Enigma pour chiffrer leurs communications. Chaque message passait "
+            "par une serie de rotors dont la position changeait a chaque lettre, ce qui rendait l'analyse "
+            "des frequences inutile. Des mathematiciens polonais reussirent pourtant a reconstituer le "
+            "cablage des rotors avant la guerre, puis transmirent leurs travaux aux services britanniques. "
+            "A Bletchley Park, une equipe reunie autour d'Alan Turing construisit des machines capables de "
+            "tester rapidement les reglages possibles en s'appuyant sur des mots probables, comme les "
+            "bulletins meteorologiques envoyes chaque matin.";
+        const char* secret_permutation = "QWERTYUIOPASDFGHJKLZXCVBNM";
+        compile_permutation_table(&secret_substitution, secret_permutation);
+        size_t held_out_len = strlen(held_out_message);
+        char* substituted = (char*)malloc(2 * held_out_len + 1);
+        if (substituted != NULL) {
+            apply_substitution(&secret_substitution, held_out_message, substituted, held_out_len);
+            substituted[held_out_len] = '\0';
+            SubstitutionCrackResult substitution_result;
+            if (crack_substitution(substituted, held_out_len, &french_quadgrams, 0, &substitution_result) == 0) {
+                printf("Clé secrète   : %s\n", secret_permutation);
+                printf("Clé retrouvée : %s (log-vraisemblance = %.2f)\n", substitution_result.key, substitution_result.score);
+                // Les lettres rares du message laissent leur image indéterminée :
+                // on mesure la part du texte correctement déchiffrée.
+                SubstitutionTable recovered, recovered_inverse;
+                compile_permutation_table(&recovered, substitution_result.key);
+                invert_substitution_table(&recovered, &recovered_inverse);
+                char* decrypted = substituted + held_out_len;
+                apply_substitution(&recovered_inverse, substituted, decrypted, held_out_len);
+                size_t letters = 0, correct = 0;
+                for (size_t i = 0; i < held_out_len; i++) {
+                    if (!isalpha((unsigned char)held_out_message[i])) continue;
+                    letters++;
+                    if (decrypted[i] == held_out_message[i]) correct++;
+                }
+                printf("Lettres correctement déchiffrées : %zu / %zu\n", correct, letters);
+            }
+            free(substituted);
+        }
+        free_quadgram_model(&french_quadgrams);
+    }
     printf("\n");
 
     // --- Note sur AES et RSA ---
@@ -1,20 +1,184 @@
 #include <stdio.h>   // Fonctions d'entrée/sortie (printf)
 #include <stdlib.h>  // Allocation mémoire (malloc, free)
-#include <string.h>  // Manipulation de chaînes (strlen, strcpy)
+#include <string.h>  // Manipulation de chaînes (strlen)
+#include <errno.h>   // Codes d'erreur (EINTR)
+#include <unistd.h>  // Entrées/sorties sur descripteurs (read, write)
+#include <thread>    // Threads (traitement par lots)
+#include <atomic>    // Distribution des lots entre les threads
+#include <vector>    // Threads lancés par run_workers
+#include <exception> // Échec de création d'un thread (std::system_error)
+
+// Taille du tampon de lecture des fonctions de chiffrement en flux
+#define STREAM_BUFFER_SIZE 65536
+// Nombre de messages distribués à la fois à un thread par le traitement par lots
+#define BATCH_CHUNK 256
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h> // Intrinsèques SSE4.1 / AVX2
+#define CESAR_HAVE_X86_SIMD 1
+#else
+#define CESAR_HAVE_X86_SIMD 0
+#endif
+
+// --- Noyaux de chiffrement de César ---
+
+// Signature commune des noyaux : transforme 'len' octets de 'in' vers 'out'
+// (in == out autorisé), avec un décalage déjà normalisé entre 0 et 25.
+typedef void (*cesar_kernel_fn)(const char* in, char* out, size_t len, int shift);
 
 /**
- * @brief Chiffre un texte en clair via le chiffrement de César.
- * @param plaintext Le texte à chiffrer.
- * @param shift Le décalage (clé de chiffrement).
- * @return La chaîne chiffrée allouée dynamiquement (à libérer par l'appelant).
+ * @brief Noyau scalaire : traite un octet par itération.
+ * Sert de référence et de traitement de la fin de tampon pour les noyaux SIMD.
  */
-char* encrypt_cesar(const char* plaintext, int shift) {
-    // Normalise le décalage entre 0 et 25.
+static void cesar_kernel_scalar(const char* in, char* out, size_t len, int shift) {
+    for (size_t i = 0; i < len; i++) {
+        char c = in[i];
+        // Traite les majuscules.
+        if (c >= 'A' && c <= 'Z') {
+            int off = c - 'A' + shift;
+            if (off >= 26) off -= 26; // Comparaison-soustraction au lieu de % 26.
+            c = off + 'A';
+        }
+        // Traite les minuscules.
+        else if (c >= 'a' && c <= 'z') {
+            int off = c - 'a' + shift;
+            if (off >= 26) off -= 26;
+            c = off + 'a';
+        }
+        // Les autres caractères sont laissés inchangés.
+        out[i] = c;
+    }
+}
+
+#if CESAR_HAVE_X86_SIMD
+/**
+ * @brief Noyau SSE4.1 : traite 16 octets par itération.
+ * Classe majuscules/minuscules par comparaisons signées (les octets >= 0x80
+ * sont négatifs et donc jamais considérés comme des lettres), ramène chaque
+ * lettre sur 0..25, ajoute le décalage puis soustrait 26 en cas de dépassement.
+ */
+__attribute__((target("sse4.1")))
+static void cesar_kernel_sse41(const char* in, char* out, size_t len, int shift) {
+    const __m128i upper_lo = _mm_set1_epi8('A' - 1);
+    const __m128i upper_hi = _mm_set1_epi8('Z' + 1);
+    const __m128i lower_lo = _mm_set1_epi8('a' - 1);
+    const __m128i lower_hi = _mm_set1_epi8('z' + 1);
+    const __m128i base_upper = _mm_set1_epi8('A');
+    const __m128i base_lower = _mm_set1_epi8('a');
+    const __m128i v_shift = _mm_set1_epi8((char)shift);
+    const __m128i v_25 = _mm_set1_epi8(25);
+    const __m128i v_26 = _mm_set1_epi8(26);
+
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i c = _mm_loadu_si128((const __m128i*)(in + i));
+        __m128i is_upper = _mm_and_si128(_mm_cmpgt_epi8(c, upper_lo), _mm_cmplt_epi8(c, upper_hi));
+        __m128i is_lower = _mm_and_si128(_mm_cmpgt_epi8(c, lower_lo), _mm_cmplt_epi8(c, lower_hi));
+        __m128i is_alpha = _mm_or_si128(is_upper, is_lower);
+        __m128i base = _mm_or_si128(_mm_and_si128(is_upper, base_upper), _mm_and_si128(is_lower, base_lower));
+
+        __m128i off = _mm_add_epi8(_mm_sub_epi8(c, base), v_shift);
+        off = _mm_sub_epi8(off, _mm_and_si128(_mm_cmpgt_epi8(off, v_25), v_26));
+        __m128i enc = _mm_add_epi8(off, base);
+
+        _mm_storeu_si128((__m128i*)(out + i), _mm_blendv_epi8(c, enc, is_alpha));
+    }
+    cesar_kernel_scalar(in + i, out + i, len - i, shift);
+}
+
+/**
+ * @brief Noyau AVX2 : même algorithme que le noyau SSE4.1, sur 32 octets.
+ */
+__attribute__((target("avx2")))
+static void cesar_kernel_avx2(const char* in, char* out, size_t len, int shift) {
+    const __m256i upper_lo = _mm256_set1_epi8('A' - 1);
+    const __m256i upper_hi = _mm256_set1_epi8('Z' + 1);
+    const __m256i lower_lo = _mm256_set1_epi8('a' - 1);
+    const __m256i lower_hi = _mm256_set1_epi8('z' + 1);
+    const __m256i base_upper = _mm256_set1_epi8('A');
+    const __m256i base_lower = _mm256_set1_epi8('a');
+    const __m256i v_shift = _mm256_set1_epi8((char)shift);
+    const __m256i v_25 = _mm256_set1_epi8(25);
+    const __m256i v_26 = _mm256_set1_epi8(26);
+
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i c = _mm256_loadu_si256((const __m256i*)(in + i));
+        __m256i is_upper = _mm256_and_si256(_mm256_cmpgt_epi8(c, upper_lo), _mm256_cmpgt_epi8(upper_hi, c));
+        __m256i is_lower = _mm256_and_si256(_mm256_cmpgt_epi8(c, lower_lo), _mm256_cmpgt_epi8(lower_hi, c));
+        __m256i is_alpha = _mm256_or_si256(is_upper, is_lower);
+        __m256i base = _mm256_or_si256(_mm256_and_si256(is_upper, base_upper), _mm256_and_si256(is_lower, base_lower));
+
+        __m256i off = _mm256_add_epi8(_mm256_sub_epi8(c, base), v_shift);
+        off = _mm256_sub_epi8(off, _mm256_and_si256(_mm256_cmpgt_epi8(off, v_25), v_26));
+        __m256i enc = _mm256_add_epi8(off, base);
+
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_blendv_epi8(c, enc, is_alpha));
+    }
+    // La fin du tampon (moins de 32 octets) passe par le noyau SSE4.1 puis scalaire.
+    cesar_kernel_sse41(in + i, out + i, len - i, shift);
+}
+#endif
+
+/**
+ * @brief Choisit le noyau le plus rapide supporté par le processeur (CPUID).
+ * Tous les noyaux produisent une sortie identique octet par octet.
+ */
+static cesar_kernel_fn select_cesar_kernel() {
+#if CESAR_HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return cesar_kernel_avx2;
+    if (__builtin_cpu_supports("sse4.1")) return cesar_kernel_sse41;
+#endif
+    return cesar_kernel_scalar;
+}
+
+// Noyau sélectionné une seule fois au démarrage du programme.
+static const cesar_kernel_fn cesar_kernel = select_cesar_kernel();
+
+/**
+ * @brief Normalise un décalage de César entre 0 et 25.
+ * @param shift Le décalage, éventuellement négatif ou supérieur à 25.
+ * @return Le décalage équivalent dans [0, 25].
+ */
+static int normalize_cesar_shift(int shift) {
     shift = shift % 26;
     if (shift < 0) {
         shift += 26;
     }
+    return shift;
+}
+
+/**
+ * @brief Chiffre 'len' octets vers un tampon fourni par l'appelant (aucune allocation).
+ * Les octets nuls sont traités comme n'importe quel caractère non alphabétique ;
+ * aucun terminateur n'est écrit. 'in' et 'out' peuvent désigner le même tampon.
+ * @param in Le texte à chiffrer.
+ * @param len Le nombre d'octets à traiter.
+ * @param out Le tampon de sortie (au moins 'len' octets).
+ * @param shift Le décalage (clé de chiffrement).
+ */
+void encrypt_cesar(const char* in, size_t len, char* out, int shift) {
+    cesar_kernel(in, out, len, normalize_cesar_shift(shift));
+}
+
+/**
+ * @brief Chiffre 'len' octets directement dans le tampon (aucune allocation).
+ * @param buf Le tampon à chiffrer sur place.
+ * @param len Le nombre d'octets à traiter.
+ * @param shift Le décalage (clé de chiffrement).
+ */
+void encrypt_cesar_inplace(char* buf, size_t len, int shift) {
+    cesar_kernel(buf, buf, len, normalize_cesar_shift(shift));
+}
 
+/**
+ * @brief Chiffre un texte en clair via le chiffrement de César.
+ * @param plaintext Le texte à chiffrer.
+ * @param shift Le décalage (clé de chiffrement).
+ * @return La chaîne chiffrée allouée dynamiquement (à libérer par l'appelant).
+ */
+char* encrypt_cesar(const char* plaintext, int shift) {
     size_t len = strlen(plaintext);
     // Alloue de la mémoire pour le texte chiffré.
     char* ciphertext = (char*)malloc((len + 1) * sizeof(char));
@@ -22,23 +186,34 @@ char* encrypt_cesar(const char* plaintext, int shift) {
         perror("Échec d'allocation mémoire");
         return NULL;
     }
-    strcpy(ciphertext, plaintext); // Copie le texte pour le modifier.
 
-    // Parcourt chaque caractère du texte.
-    for (size_t i = 0; i < len; i++) {
-        // Traite les majuscules.
-        if (ciphertext[i] >= 'A' && ciphertext[i] <= 'Z') {
-            ciphertext[i] = ((ciphertext[i] - 'A' + shift) % 26) + 'A';
-        } 
-        // Traite les minuscules.
-        else if (ciphertext[i] >= 'a' && ciphertext[i] <= 'z') {
-            ciphertext[i] = ((ciphertext[i] - 'a' + shift) % 26) + 'a';
-        }
-        // Les autres caractères sont laissés inchangés.
-    }
+    // Chiffre directement de l'entrée vers la sortie, sans copie préalable.
+    encrypt_cesar(plaintext, len, ciphertext, shift);
+    ciphertext[len] = '\0';
     return ciphertext;
 }
 
+/**
+ * @brief Déchiffre 'len' octets vers un tampon fourni par l'appelant (aucune allocation).
+ * @param in Le texte à déchiffrer.
+ * @param len Le nombre d'octets à traiter.
+ * @param out Le tampon de sortie (au moins 'len' octets).
+ * @param shift Le décalage (clé de déchiffrement).
+ */
+void decrypt_cesar(const char* in, size_t len, char* out, int shift) {
+    encrypt_cesar(in, len, out, -normalize_cesar_shift(shift));
+}
+
+/**
+ * @brief Déchiffre 'len' octets directement dans le tampon (aucune allocation).
+ * @param buf Le tampon à déchiffrer sur place.
+ * @param len Le nombre d'octets à traiter.
+ * @param shift Le décalage (clé de déchiffrement).
+ */
+void decrypt_cesar_inplace(char* buf, size_t len, int shift) {
+    encrypt_cesar_inplace(buf, len, -normalize_cesar_shift(shift));
+}
+
 /**
  * @brief Déchiffre un texte chiffré de César.
  * @param ciphertext Le texte à déchiffrer.
@@ -47,7 +222,179 @@ char* encrypt_cesar(const char* plaintext, int shift) {
  */
 char* decrypt_cesar(const char* ciphertext, int shift) {
     // Le déchiffrement est un chiffrement avec un décalage négatif.
-    return encrypt_cesar(ciphertext, -shift);
+    return encrypt_cesar(ciphertext, -normalize_cesar_shift(shift));
+}
+
+// --- Chiffrement en flux (mémoire constante) ---
+
+// Contexte de chiffrement de César en flux. César ne dépendant pas de la
+// position, le contexte ne conserve que le décalage normalisé.
+typedef struct {
+    int shift;
+} CesarStream;
+
+/**
+ * @brief Initialise un contexte de chiffrement de César en flux.
+ * @param ctx Le contexte à initialiser.
+ * @param shift Le décalage (clé).
+ * @param decrypt 0 pour chiffrer, 1 pour déchiffrer.
+ */
+void cesar_stream_init(CesarStream* ctx, int shift, int decrypt) {
+    shift = normalize_cesar_shift(shift);
+    ctx->shift = decrypt ? normalize_cesar_shift(-shift) : shift;
+}
+
+/**
+ * @brief Chiffre un morceau du flux (aucune allocation, in == out autorisé).
+ * @param ctx Le contexte initialisé par cesar_stream_init().
+ * @param in Le morceau à traiter.
+ * @param len Le nombre d'octets du morceau.
+ * @param out Le tampon de sortie (au moins 'len' octets).
+ */
+void cesar_stream_update(CesarStream* ctx, const char* in, size_t len, char* out) {
+    cesar_kernel(in, out, len, ctx->shift);
+}
+
+/**
+ * @brief Termine le flux. César ne retenant aucun octet, rien n'est à vider.
+ * @param ctx Le contexte à terminer.
+ * @return Le nombre d'octets restant à écrire (toujours 0).
+ */
+size_t cesar_stream_final(CesarStream* ctx) {
+    ctx->shift = 0;
+    return 0;
+}
+
+/**
+ * @brief Écrit l'intégralité d'un tampon sur un descripteur (gère les écritures partielles).
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+static int write_all(int fd, const char* buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Chiffre tout le contenu d'un descripteur vers un autre, par tampons de taille fixe.
+ * La mémoire utilisée est constante quelle que soit la taille de l'entrée.
+ * @param in_fd Le descripteur source.
+ * @param out_fd Le descripteur destination.
+ * @param shift Le décalage (clé de chiffrement).
+ * @return 0 en cas de succès, -1 en cas d'erreur d'entrée/sortie.
+ */
+int encrypt_cesar_fd(int in_fd, int out_fd, int shift) {
+    char buffer[STREAM_BUFFER_SIZE];
+    CesarStream ctx;
+    cesar_stream_init(&ctx, shift, 0);
+
+    for (;;) {
+        ssize_t n = read(in_fd, buffer, sizeof(buffer));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("Erreur de lecture");
+            return -1;
+        }
+        if (n == 0) break; // Fin du flux
+        cesar_stream_update(&ctx, buffer, (size_t)n, buffer);
+        if (write_all(out_fd, buffer, (size_t)n) == -1) {
+            perror("Erreur d'écriture");
+            return -1;
+        }
+    }
+    cesar_stream_final(&ctx);
+    return 0;
+}
+
+// --- Exécution parallèle ---
+
+/**
+ * @brief Choisit le nombre de threads pour 'work_items' tâches indépendantes.
+ * @return Le nombre de cœurs disponibles, borné par le nombre de tâches (au moins 1).
+ */
+static unsigned worker_count(size_t work_items) {
+    unsigned thread_count = std::thread::hardware_concurrency();
+    if (thread_count == 0) thread_count = 1;
+    if (thread_count > work_items) thread_count = work_items > 0 ? (unsigned)work_items : 1;
+    return thread_count;
+}
+
+/**
+ * @brief Exécute worker(0) ... worker(thread_count - 1) en parallèle.
+ * Le thread appelant exécute worker(0). Si un thread ne peut être créé
+ * (std::system_error), les indices restants sont exécutés par le thread
+ * appelant : chaque indice est exécuté exactement une fois et les threads déjà
+ * lancés sont toujours attendus. Les workers se partageant le travail par
+ * compteur atomique, un worker exécuté en retard trouve simplement moins de tâches.
+ */
+template <typename F>
+static void run_workers(unsigned thread_count, F worker) {
+    std::vector<std::thread> threads;
+    unsigned started = 1;
+    try {
+        threads.reserve(thread_count - 1);
+        for (; started < thread_count; started++) {
+            threads.emplace_back(worker, started);
+        }
+    } catch (const std::exception&) {
+        // Plus de threads (ou de mémoire) disponibles : le thread appelant fait le reste
+    }
+    worker(0u);
+    for (unsigned t = started; t < thread_count; t++) {
+        worker(t);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+// --- Traitement par lots ---
+
+// Message d'un lot : une tranche de l'arène d'entrée et son propre décalage.
+// Le résultat est écrit à la même position dans l'arène de sortie.
+typedef struct {
+    size_t offset; // Position du message dans l'arène
+    size_t length; // Nombre d'octets du message
+    int shift;     // Décalage (clé) du message
+} CesarRecord;
+
+/**
+ * @brief Chiffre (ou déchiffre) un lot de messages courts, chacun avec son propre décalage.
+ *
+ * Tous les messages sont lus dans une même arène contiguë et écrits dans une
+ * arène de sortie de même disposition : ni strlen ni allocation par message.
+ * Les enregistrements sont distribués par paquets de BATCH_CHUNK entre les
+ * threads, ce qui amortit le coût d'ordonnancement sur des millions de messages.
+ *
+ * @param in_arena L'arène contenant les messages.
+ * @param out_arena L'arène de sortie (même taille ; in_arena == out_arena autorisé).
+ * @param records Les messages à traiter.
+ * @param count Le nombre de messages.
+ * @param decrypt 0 pour chiffrer, 1 pour déchiffrer.
+ */
+void encrypt_cesar_batch(const char* in_arena, char* out_arena, const CesarRecord* records, size_t count, int decrypt) {
+    std::atomic<size_t> next_record(0);
+    auto worker = [&](unsigned) {
+        for (size_t first = next_record.fetch_add(BATCH_CHUNK); first < count;
+             first = next_record.fetch_add(BATCH_CHUNK)) {
+            size_t last = first + BATCH_CHUNK < count ? first + BATCH_CHUNK : count;
+            for (size_t r = first; r < last; r++) {
+                int shift = normalize_cesar_shift(records[r].shift);
+                if (decrypt) shift = normalize_cesar_shift(-shift);
+                cesar_kernel(in_arena + records[r].offset, out_arena + records[r].offset, records[r].length, shift);
+            }
+        }
+    };
+    size_t chunks = (count + BATCH_CHUNK - 1) / BATCH_CHUNK;
+    unsigned thread_count = worker_count(chunks);
+    run_workers(thread_count, worker); // Le thread appelant participe aussi
 }
 
 /**
@@ -75,5 +422,22 @@ int main() {
         free(encrypted_name); // Libère la mémoire du texte chiffré.
     }
 
+    // Variante sans allocation : chiffrement puis déchiffrement sur place.
+    char buffer[] = "BOUBACAR";
+    size_t buffer_len = sizeof(buffer) - 1;
+    encrypt_cesar_inplace(buffer, buffer_len, encryption_shift);
+    printf("Chiffré sur place: \"%s\"\n", buffer);
+    decrypt_cesar_inplace(buffer, buffer_len, encryption_shift);
+    printf("Déchiffré sur place: \"%s\"\n", buffer);
+
+    // Traitement par lots : plusieurs messages d'une même arène, chacun avec son décalage.
+    char arena[] = "BOUBACAR" "CRYPTOGRAPHIE" "CESAR";
+    CesarRecord records[] = {{0, 8, 3}, {8, 13, 7}, {21, 5, 25}};
+    size_t record_count = sizeof(records) / sizeof(records[0]);
+    encrypt_cesar_batch(arena, arena, records, record_count, 0);
+    printf("Lot chiffré: \"%s\"\n", arena);
+    encrypt_cesar_batch(arena, arena, records, record_count, 1);
+    printf("Lot déchiffré: \"%s\"\n", arena);
+
     return 0;
 }
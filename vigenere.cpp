@@ -2,138 +2,1944 @@
 #include <stdlib.h>  // Pour malloc et free (gestion de la mémoire dynamique)
 #include <string.h>  // Pour strlen, strcpy, strcspn (manipulation de chaînes de caractères)
 #include <ctype.h>   // Pour isalpha, isupper, toupper (vérification/conversion de caractères)
+#include <stdint.h>  // Pour uint8_t (tableau compact de décalages)
+#include <math.h>    // Pour cos, sin, floor (transformée de Fourier)
+#include <errno.h>   // Pour EINTR (lectures/écritures interrompues)
+#include <unistd.h>  // Pour read, write (entrées/sorties sur descripteurs)
+#include <thread>    // Pour std::thread (évaluation parallèle des périodes candidates)
+#include <atomic>    // Pour std::atomic (distribution du travail entre les threads)
+#include <vector>    // Pour std::vector (threads lancés par run_workers)
+#include <exception> // Pour std::exception (échec de création d'un thread)
+#include <algorithm> // Pour std::sort (tri des seaux du tableau des suffixes)
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h> // Intrinsèques SSE4.1 / AVX2
+#define VIGENERE_HAVE_X86_SIMD 1
+#else
+#define VIGENERE_HAVE_X86_SIMD 0
+#endif
+
+// Nombre de décalages recopiés après la fin de la période, pour qu'un bloc
+// vectoriel de 32 lettres puisse charger le motif de la clé d'un seul tenant
+// quelle que soit la position courante.
+#define VIGENERE_KEY_PADDING 32
+
+// Taille du tampon de lecture des fonctions de chiffrement en flux
+#define STREAM_BUFFER_SIZE 65536
+
+// Nombre de messages distribués à la fois à un thread par le traitement par lots
+#define BATCH_CHUNK 256
+
+#define ALPHABET_SIZE 26 // Taille de l'alphabet (A-Z)
+#define FRENCH_IC 0.0778 // Indice de coïncidence d'un texte français
+#define RANDOM_IC (1.0 / ALPHABET_SIZE) // Indice de coïncidence d'un texte aléatoire
+#define VIGENERE_MAX_PERIOD 32 // Plus grande longueur de clé envisagée par défaut lors du cassage
+#define COSET_BLOCK 4096 // Nombre de lettres transposées par bloc (tient dans le cache L1)
+#define KASISKI_MIN_LENGTH 3 // Longueur minimale par défaut des répétitions du test de Kasiski
+#define KASISKI_MAX_LENGTH 12 // Profondeur maximale du tri des suffixes pour le test de Kasiski
+#define KASISKI_MAX_GCD 65536 // Plus grand PGCD de distances retenu par le test de Kasiski
+#define FFT_CACHE_BLOCK 4096 // Points de FFT traités ensemble par bloc (64 Ko, tient dans le cache L2)
+#define AUTOKEY_CANDIDATES 4 // Lettres d'amorce retenues par chaîne par le pré-filtre d'unigrammes
+
+// Clé de Vigenère précompilée : les lettres de la clé sont converties une
+// seule fois en décalages (0-25), les caractères non alphabétiques ignorés.
+// Les décalages de déchiffrement ((26 - s) % 26) sont stockés à la suite pour
+// que chiffrement et déchiffrement se réduisent à une addition par lettre.
+// Chaque tableau est prolongé de VIGENERE_KEY_PADDING éléments qui répètent
+// la clé : shifts[k + j] == shifts[(k + j) % length] pour k < length.
+typedef struct {
+    uint8_t* shifts;     // Décalages de chiffrement, 'length' + VIGENERE_KEY_PADDING éléments
+    uint8_t* inv_shifts; // Décalages de déchiffrement, même taille
+    size_t length;       // Nombre de lettres de la clé (période)
+} VigenereKey;
+
+/**
+ * @brief Convertit les lettres d'une clé en décalages, prolongés de VIGENERE_KEY_PADDING éléments.
+ * @param key_text La clé textuelle (les caractères non alphabétiques sont ignorés).
+ * @param key_len Le nombre d'octets de la clé.
+ * @param inverse 0 pour les décalages de chiffrement, 1 pour ceux de déchiffrement.
+ * @param shifts Le tableau à remplir (au moins nombre de lettres + VIGENERE_KEY_PADDING éléments).
+ * @return Le nombre de lettres de la clé (rien n'est écrit si elle n'en contient aucune).
+ */
+static size_t fill_vigenere_shifts(const char* key_text, size_t key_len, int inverse, uint8_t* shifts) {
+    size_t letters = 0;
+    for (size_t i = 0; i < key_len; i++) {
+        if (isalpha((unsigned char)key_text[i])) {
+            uint8_t shift = (uint8_t)(toupper((unsigned char)key_text[i]) - 'A');
+            shifts[letters++] = inverse ? (uint8_t)((26 - shift) % 26) : shift;
+        }
+    }
+    // Recopie le motif périodique au-delà de la fin de la clé.
+    for (size_t i = letters; letters > 0 && i < letters + VIGENERE_KEY_PADDING; i++) {
+        shifts[i] = shifts[i % letters];
+    }
+    return letters;
+}
+
+/**
+ * @brief Compile une clé de Vigenère textuelle en tableau de décalages.
+ *
+ * Alloue dynamiquement les tableaux de décalages.
+ * L'appelant est responsable de les libérer avec free_vigenere_key().
+ *
+ * @param key_text La clé textuelle (les caractères non alphabétiques sont ignorés).
+ * @param key La structure à remplir.
+ * @return 0 en cas de succès, -1 si la clé ne contient aucune lettre ou en cas d'erreur d'allocation.
+ */
+int compile_vigenere_key(const char* key_text, VigenereKey* key) {
+    size_t key_len = strlen(key_text);
+    size_t letters = 0;
+    for (size_t i = 0; i < key_len; i++) {
+        if (isalpha((unsigned char)key_text[i])) letters++;
+    }
+    if (letters == 0) {
+        fprintf(stderr, "Erreur: La clé ne contient aucun caractère alphabétique valide.\n");
+        return -1;
+    }
+
+    size_t padded = letters + VIGENERE_KEY_PADDING;
+    uint8_t* storage = (uint8_t*)malloc(2 * padded * sizeof(uint8_t));
+    if (storage == NULL) {
+        perror("Échec de l'allocation mémoire pour la clé");
+        return -1;
+    }
+    key->shifts = storage;
+    key->inv_shifts = storage + padded;
+    key->length = letters;
+    fill_vigenere_shifts(key_text, key_len, 0, key->shifts);
+    fill_vigenere_shifts(key_text, key_len, 1, key->inv_shifts);
+    return 0;
+}
+
+/**
+ * @brief Libère les tableaux d'une clé compilée par compile_vigenere_key().
+ * @param key La clé à libérer.
+ */
+void free_vigenere_key(VigenereKey* key) {
+    free(key->shifts); // 'inv_shifts' partage la même allocation
+    key->shifts = NULL;
+    key->inv_shifts = NULL;
+    key->length = 0;
+}
+
+// Signature commune des noyaux de Vigenère : applique une suite périodique de
+// décalages aux lettres d'un tampon. Seules les lettres consomment un décalage ;
+// la position dans la clé est lue puis mise à jour via 'key_pos'.
+// 'shifts' doit être prolongé de VIGENERE_KEY_PADDING éléments (voir VigenereKey).
+// 'in' et 'out' peuvent être identiques.
+typedef void (*vigenere_kernel_fn)(const uint8_t* shifts, size_t period, size_t* key_pos,
+                                   const char* in, char* out, size_t len);
+
+/**
+ * @brief Noyau scalaire : traite un octet par itération.
+ * Sert de référence et de traitement de la fin de tampon pour les noyaux SIMD.
+ */
+static void vigenere_kernel_scalar(const uint8_t* shifts, size_t period, size_t* key_pos,
+                                   const char* in, char* out, size_t len) {
+    size_t k = *key_pos;
+    for (size_t i = 0; i < len; i++) {
+        char c = in[i];
+        char base;
+        if (c >= 'A' && c <= 'Z') {
+            base = 'A';
+        } else if (c >= 'a' && c <= 'z') {
+            base = 'a';
+        } else {
+            out[i] = c; // Les caractères non alphabétiques sont laissés inchangés
+            continue;
+        }
+        int off = c - base + shifts[k];
+        if (off >= 26) off -= 26; // Comparaison-soustraction au lieu de % 26
+        out[i] = (char)(off + base);
+        if (++k == period) k = 0;
+    }
+    *key_pos = k;
+}
+
+#if VIGENERE_HAVE_X86_SIMD
+/**
+ * @brief Chiffre un bloc de 16 octets quelconques (lettres et ponctuation mêlées).
+ *
+ * Le rang de chaque lettre parmi les lettres du bloc est obtenu par une somme
+ * préfixe du masque alphabétique ; pshufb sélectionne alors, pour chaque lettre,
+ * le décalage shifts[k + rang]. Les octets non alphabétiques sont masqués.
+ *
+ * @param consumed Reçoit le nombre de lettres du bloc (décalages consommés).
+ */
+__attribute__((target("sse4.1")))
+static inline __m128i vigenere_block16(__m128i c, const uint8_t* shifts, size_t k, int* consumed) {
+    __m128i is_upper = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('Z' + 1)));
+    __m128i is_lower = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('z' + 1)));
+    __m128i is_alpha = _mm_or_si128(is_upper, is_lower);
+    __m128i base = _mm_or_si128(_mm_and_si128(is_upper, _mm_set1_epi8('A')), _mm_and_si128(is_lower, _mm_set1_epi8('a')));
+
+    // Rang exclusif de chaque octet parmi les lettres du bloc.
+    __m128i ones = _mm_and_si128(is_alpha, _mm_set1_epi8(1));
+    __m128i rank = _mm_add_epi8(ones, _mm_slli_si128(ones, 1));
+    rank = _mm_add_epi8(rank, _mm_slli_si128(rank, 2));
+    rank = _mm_add_epi8(rank, _mm_slli_si128(rank, 4));
+    rank = _mm_add_epi8(rank, _mm_slli_si128(rank, 8));
+    rank = _mm_sub_epi8(rank, ones);
+
+    __m128i shift = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(shifts + k)), rank);
+    __m128i off = _mm_add_epi8(_mm_sub_epi8(c, base), shift);
+    off = _mm_sub_epi8(off, _mm_and_si128(_mm_cmpgt_epi8(off, _mm_set1_epi8(25)), _mm_set1_epi8(26)));
+
+    *consumed = __builtin_popcount(_mm_movemask_epi8(is_alpha));
+    return _mm_blendv_epi8(c, _mm_add_epi8(off, base), is_alpha);
+}
+
+/**
+ * @brief Noyau SSE4.1 : 16 octets par itération via vigenere_block16().
+ */
+__attribute__((target("sse4.1")))
+static void vigenere_kernel_sse41(const uint8_t* shifts, size_t period, size_t* key_pos,
+                                  const char* in, char* out, size_t len) {
+    size_t k = *key_pos;
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        int consumed;
+        __m128i c = _mm_loadu_si128((const __m128i*)(in + i));
+        _mm_storeu_si128((__m128i*)(out + i), vigenere_block16(c, shifts, k, &consumed));
+        k = (k + consumed) % period;
+    }
+    *key_pos = k;
+    vigenere_kernel_scalar(shifts, period, key_pos, in + i, out + i, len - i);
+}
+
+/**
+ * @brief Noyau AVX2 : 32 lettres par itération.
+ *
+ * Lorsque le bloc ne contient que des lettres (cas courant des charges A-Z),
+ * le motif périodique de la clé est chargé directement depuis shifts + k et
+ * ajouté aux 32 octets. Un bloc mêlant ponctuation et lettres est traité en
+ * deux moitiés par vigenere_block16() ; un bloc sans lettre est recopié.
+ */
+__attribute__((target("avx2")))
+static void vigenere_kernel_avx2(const uint8_t* shifts, size_t period, size_t* key_pos,
+                                 const char* in, char* out, size_t len) {
+    const __m256i upper_lo = _mm256_set1_epi8('A' - 1);
+    const __m256i upper_hi = _mm256_set1_epi8('Z' + 1);
+    const __m256i lower_lo = _mm256_set1_epi8('a' - 1);
+    const __m256i lower_hi = _mm256_set1_epi8('z' + 1);
+    const __m256i base_upper = _mm256_set1_epi8('A');
+    const __m256i base_lower = _mm256_set1_epi8('a');
+    const __m256i v_25 = _mm256_set1_epi8(25);
+    const __m256i v_26 = _mm256_set1_epi8(26);
+    const size_t step = 32 % period; // Avance de la clé après un bloc entièrement alphabétique
+
+    size_t k = *key_pos;
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i c = _mm256_loadu_si256((const __m256i*)(in + i));
+        __m256i is_upper = _mm256_and_si256(_mm256_cmpgt_epi8(c, upper_lo), _mm256_cmpgt_epi8(upper_hi, c));
+        __m256i is_lower = _mm256_and_si256(_mm256_cmpgt_epi8(c, lower_lo), _mm256_cmpgt_epi8(lower_hi, c));
+        __m256i is_alpha = _mm256_or_si256(is_upper, is_lower);
+        unsigned mask = (unsigned)_mm256_movemask_epi8(is_alpha);
+
+        if (mask == 0xFFFFFFFFu) {
+            __m256i base = _mm256_or_si256(_mm256_and_si256(is_upper, base_upper), _mm256_and_si256(is_lower, base_lower));
+            __m256i shift = _mm256_loadu_si256((const __m256i*)(shifts + k));
+            __m256i off = _mm256_add_epi8(_mm256_sub_epi8(c, base), shift);
+            off = _mm256_sub_epi8(off, _mm256_and_si256(_mm256_cmpgt_epi8(off, v_25), v_26));
+            _mm256_storeu_si256((__m256i*)(out + i), _mm256_add_epi8(off, base));
+            k += step;
+            if (k >= period) k -= period;
+        } else if (mask == 0) {
+            _mm256_storeu_si256((__m256i*)(out + i), c);
+        } else {
+            int consumed;
+            __m128i lo = vigenere_block16(_mm256_castsi256_si128(c), shifts, k, &consumed);
+            _mm_storeu_si128((__m128i*)(out + i), lo);
+            k = (k + consumed) % period;
+            __m128i hi = vigenere_block16(_mm256_extracti128_si256(c, 1), shifts, k, &consumed);
+            _mm_storeu_si128((__m128i*)(out + i + 16), hi);
+            k = (k + consumed) % period;
+        }
+    }
+    *key_pos = k;
+    vigenere_kernel_sse41(shifts, period, key_pos, in + i, out + i, len - i);
+}
+#endif
+
+/**
+ * @brief Choisit le noyau le plus rapide supporté par le processeur (CPUID).
+ * Tous les noyaux produisent une sortie identique octet par octet.
+ */
+static vigenere_kernel_fn select_vigenere_kernel() {
+#if VIGENERE_HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return vigenere_kernel_avx2;
+    if (__builtin_cpu_supports("sse4.1")) return vigenere_kernel_sse41;
+#endif
+    return vigenere_kernel_scalar;
+}
+
+// Noyau sélectionné une seule fois au démarrage du programme.
+static const vigenere_kernel_fn vigenere_apply = select_vigenere_kernel();
+
+/**
+ * @brief Chiffre un texte en clair avec une clé de Vigenère précompilée.
+ *
+ * Alloue dynamiquement de la mémoire pour le texte chiffré.
+ * L'appelant est responsable de libérer cette mémoire avec free().
+ *
+ * @param plaintext Le texte en clair à chiffrer.
+ * @param key La clé compilée par compile_vigenere_key().
+ * @return Un pointeur vers la chaîne de caractères chiffrée, ou NULL en cas d'erreur.
+ */
+char* encrypt_vigenere(const char* plaintext, const VigenereKey* key) {
+    size_t plain_len = strlen(plaintext);
+
+    // Alloue de la mémoire pour le texte chiffré (+1 pour le caractère nul de fin de chaîne)
+    char* ciphertext = (char*)malloc((plain_len + 1) * sizeof(char));
+    if (ciphertext == NULL) {
+        perror("Échec de l'allocation mémoire pour le texte chiffré");
+        return NULL;
+    }
+
+    size_t key_pos = 0;
+    vigenere_apply(key->shifts, key->length, &key_pos, plaintext, ciphertext, plain_len);
+    ciphertext[plain_len] = '\0'; // Termine la chaîne avec un caractère nul
+
+    return ciphertext;
+}
+
+/**
+ * @brief Déchiffre un texte chiffré avec une clé de Vigenère précompilée.
+ *
+ * Alloue dynamiquement de la mémoire pour le texte déchiffré.
+ * L'appelant est responsable de libérer cette mémoire avec free().
+ *
+ * @param ciphertext Le texte chiffré à déchiffrer.
+ * @param key La clé compilée utilisée pour le chiffrement.
+ * @return Un pointeur vers la chaîne de caractères déchiffrée, ou NULL en cas d'erreur.
+ */
+char* decrypt_vigenere(const char* ciphertext, const VigenereKey* key) {
+    size_t cipher_len = strlen(ciphertext);
+
+    // Alloue de la mémoire pour le texte clair (+1 pour le caractère nul de fin de chaîne)
+    char* plaintext = (char*)malloc((cipher_len + 1) * sizeof(char));
+    if (plaintext == NULL) {
+        perror("Échec de l'allocation mémoire pour le texte clair");
+        return NULL;
+    }
+
+    // Le déchiffrement ajoute les décalages inverses
+    size_t key_pos = 0;
+    vigenere_apply(key->inv_shifts, key->length, &key_pos, ciphertext, plaintext, cipher_len);
+    plaintext[cipher_len] = '\0'; // Termine la chaîne avec un caractère nul
+
+    return plaintext;
+}
+
+/**
+ * @brief Chiffre un texte en clair en utilisant le chiffrement de Vigenère.
+ *
+ * Alloue dynamiquement de la mémoire pour le texte chiffré.
+ * L'appelant est responsable de libérer cette mémoire avec free().
+ * Pour chiffrer plusieurs messages avec la même clé, préférer
+ * compile_vigenere_key() suivi de la surcharge prenant un VigenereKey.
+ *
+ * @param plaintext Le texte en clair à chiffrer.
+ * @param key La clé de chiffrement.
+ * @return Un pointeur vers la chaîne de caractères chiffrée, ou NULL en cas d'erreur.
+ */
+char* encrypt_vigenere(const char* plaintext, const char* key) {
+    VigenereKey compiled_key;
+    if (compile_vigenere_key(key, &compiled_key) == -1) {
+        return NULL;
+    }
+    char* ciphertext = encrypt_vigenere(plaintext, &compiled_key);
+    free_vigenere_key(&compiled_key);
+    return ciphertext;
+}
+
+/**
+ * @brief Déchiffre un texte chiffré en utilisant le chiffrement de Vigenère.
+ *
+ * Alloue dynamiquement de la mémoire pour le texte déchiffré.
+ * L'appelant est responsable de libérer cette mémoire avec free().
+ *
+ * @param ciphertext Le texte chiffré à déchiffrer.
+ * @param key La clé de déchiffrement (doit être la même que celle utilisée pour le chiffrement).
+ * @return Un pointeur vers la chaîne de caractères déchiffrée, ou NULL en cas d'erreur.
+ */
+char* decrypt_vigenere(const char* ciphertext, const char* key) {
+    VigenereKey compiled_key;
+    if (compile_vigenere_key(key, &compiled_key) == -1) {
+        return NULL;
+    }
+    char* plaintext = decrypt_vigenere(ciphertext, &compiled_key);
+    free_vigenere_key(&compiled_key);
+    return plaintext;
+}
+
+// --- Variantes : Beaufort, Beaufort variante et autoclave ---
+
+/**
+ * @brief Remplace chaque lettre par son opposé modulo 26 (A -> A, B -> Z, C -> Y...), casse conservée.
+ * Boucle sans dépendance entre octets, vectorisée par le compilateur.
+ */
+static void negate_letters(char* buf, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        char c = buf[i];
+        char base = (c >= 'A' && c <= 'Z') ? 'A' : ((c >= 'a' && c <= 'z') ? 'a' : 0);
+        if (base != 0 && c != base) {
+            buf[i] = (char)(2 * base + ALPHABET_SIZE - c);
+        }
+    }
+}
+
+/**
+ * @brief Chiffre (ou déchiffre) un tampon par Beaufort : c = k - p (mod 26).
+ *
+ * Beaufort est l'opposé du déchiffrement de Vigenère, -(p - k) : le noyau de
+ * Vigenère est appliqué avec les décalages inverses de la clé compilée, puis
+ * les lettres sont remplacées par leur opposé. Le chiffrement étant une
+ * involution, la même fonction déchiffre.
+ *
+ * @param in Le texte à traiter.
+ * @param len Le nombre d'octets du texte.
+ * @param key La clé compilée par compile_vigenere_key().
+ * @param out Le tampon de sortie (au moins 'len' octets, in == out autorisé).
+ */
+void encrypt_beaufort(const char* in, size_t len, const VigenereKey* key, char* out) {
+    size_t key_pos = 0;
+    vigenere_apply(key->inv_shifts, key->length, &key_pos, in, out, len);
+    negate_letters(out, len);
+}
+
+/**
+ * @brief Chiffre un texte par Beaufort avec une clé précompilée.
+ * L'appelant est responsable de libérer le résultat avec free().
+ * Beaufort étant une involution, la même fonction déchiffre.
+ * @param text Le texte à chiffrer ou déchiffrer.
+ * @param key La clé compilée par compile_vigenere_key().
+ * @return Le texte transformé alloué dynamiquement, ou NULL en cas d'erreur.
+ */
+char* encrypt_beaufort(const char* text, const VigenereKey* key) {
+    size_t len = strlen(text);
+    char* out = (char*)malloc((len + 1) * sizeof(char));
+    if (out == NULL) {
+        perror("Échec de l'allocation mémoire pour le texte chiffré");
+        return NULL;
+    }
+    encrypt_beaufort(text, len, key, out);
+    out[len] = '\0';
+    return out;
+}
+
+/**
+ * @brief Déchiffre un texte chiffré par Beaufort (identique au chiffrement).
+ */
+char* decrypt_beaufort(const char* ciphertext, const VigenereKey* key) {
+    return encrypt_beaufort(ciphertext, key);
+}
+
+/**
+ * @brief Chiffre un texte par Beaufort variante : c = p - k (mod 26).
+ * C'est exactement le déchiffrement de Vigenère : les décalages inverses sont appliqués.
+ * L'appelant est responsable de libérer le résultat avec free().
+ */
+char* encrypt_variant_beaufort(const char* plaintext, const VigenereKey* key) {
+    return decrypt_vigenere(plaintext, key);
+}
+
+/**
+ * @brief Déchiffre un texte chiffré par Beaufort variante (chiffrement de Vigenère).
+ * L'appelant est responsable de libérer le résultat avec free().
+ */
+char* decrypt_variant_beaufort(const char* ciphertext, const VigenereKey* key) {
+    return encrypt_vigenere(ciphertext, key);
+}
+
+/**
+ * @brief Chiffre un tampon par Vigenère autoclave : la clé est l'amorce suivie du texte clair lui-même.
+ *
+ * Le texte clair étant connu, toute la suite de décalages (amorce, puis
+ * lettres du clair) est construite d'avance et traitée comme une clé de
+ * période égale au nombre de lettres : le chiffrement passe par le même
+ * noyau SIMD que Vigenère.
+ *
+ * @param in Le texte clair.
+ * @param len Le nombre d'octets du texte.
+ * @param primer L'amorce compilée par compile_vigenere_key().
+ * @param out Le tampon de sortie (au moins 'len' octets, in == out autorisé).
+ * @return 0 en cas de succès, -1 en cas d'erreur d'allocation.
+ */
+int encrypt_autokey(const char* in, size_t len, const VigenereKey* primer, char* out) {
+    // Suite des décalages, prolongée de VIGENERE_KEY_PADDING éléments comme une clé compilée
+    uint8_t* shifts = (uint8_t*)calloc(len + VIGENERE_KEY_PADDING, sizeof(uint8_t));
+    if (shifts == NULL) {
+        perror("Échec de l'allocation mémoire pour la clé");
+        return -1;
+    }
+    size_t letters = 0;
+    for (size_t i = 0; i < len; i++) {
+        unsigned letter = ((unsigned char)in[i] | 0x20) - 'a';
+        if (letter >= ALPHABET_SIZE) continue;
+        if (letters < primer->length) shifts[letters] = primer->shifts[letters];
+        if (letters + primer->length < len) shifts[letters + primer->length] = (uint8_t)letter;
+        letters++;
+    }
+    if (letters == 0) {
+        memmove(out, in, len);
+    } else {
+        size_t key_pos = 0;
+        vigenere_apply(shifts, letters, &key_pos, in, out, len);
+    }
+    free(shifts);
+    return 0;
+}
+
+/**
+ * @brief Déchiffre un tampon chiffré par Vigenère autoclave.
+ * Chaque lettre claire sert de clé 'length' lettres plus loin : le
+ * déchiffrement est séquentiel et garde les dernières lettres claires dans un
+ * tampon circulaire de la taille de l'amorce.
+ * @param in Le texte chiffré.
+ * @param len Le nombre d'octets du texte.
+ * @param primer L'amorce compilée par compile_vigenere_key().
+ * @param out Le tampon de sortie (au moins 'len' octets, in == out autorisé).
+ * @return 0 en cas de succès, -1 en cas d'erreur d'allocation.
+ */
+int decrypt_autokey(const char* in, size_t len, const VigenereKey* primer, char* out) {
+    size_t period = primer->length;
+    uint8_t* history = (uint8_t*)malloc(period);
+    if (history == NULL) {
+        perror("Échec de l'allocation mémoire pour la clé");
+        return -1;
+    }
+    memcpy(history, primer->shifts, period); // Les 'period' premières lettres utilisent l'amorce
+    size_t slot = 0;
+    for (size_t i = 0; i < len; i++) {
+        char c = in[i];
+        char base;
+        if (c >= 'A' && c <= 'Z') {
+            base = 'A';
+        } else if (c >= 'a' && c <= 'z') {
+            base = 'a';
+        } else {
+            out[i] = c;
+            continue;
+        }
+        int p = c - base - history[slot];
+        if (p < 0) p += ALPHABET_SIZE;
+        out[i] = (char)(p + base);
+        history[slot] = (uint8_t)p;
+        if (++slot == period) slot = 0;
+    }
+    free(history);
+    return 0;
+}
+
+/**
+ * @brief Chiffre un texte par Vigenère autoclave.
+ * L'appelant est responsable de libérer le résultat avec free().
+ * @param plaintext Le texte clair.
+ * @param primer L'amorce compilée par compile_vigenere_key().
+ * @return Le texte chiffré alloué dynamiquement, ou NULL en cas d'erreur.
+ */
+char* encrypt_autokey(const char* plaintext, const VigenereKey* primer) {
+    size_t len = strlen(plaintext);
+    char* ciphertext = (char*)malloc((len + 1) * sizeof(char));
+    if (ciphertext == NULL) {
+        perror("Échec de l'allocation mémoire pour le texte chiffré");
+        return NULL;
+    }
+    if (encrypt_autokey(plaintext, len, primer, ciphertext) == -1) {
+        free(ciphertext);
+        return NULL;
+    }
+    ciphertext[len] = '\0';
+    return ciphertext;
+}
+
+/**
+ * @brief Déchiffre un texte chiffré par Vigenère autoclave.
+ * L'appelant est responsable de libérer le résultat avec free().
+ * @param ciphertext Le texte chiffré.
+ * @param primer L'amorce compilée par compile_vigenere_key().
+ * @return Le texte clair alloué dynamiquement, ou NULL en cas d'erreur.
+ */
+char* decrypt_autokey(const char* ciphertext, const VigenereKey* primer) {
+    size_t len = strlen(ciphertext);
+    char* plaintext = (char*)malloc((len + 1) * sizeof(char));
+    if (plaintext == NULL) {
+        perror("Échec de l'allocation mémoire pour le texte clair");
+        return NULL;
+    }
+    if (decrypt_autokey(ciphertext, len, primer, plaintext) == -1) {
+        free(plaintext);
+        return NULL;
+    }
+    plaintext[len] = '\0';
+    return plaintext;
+}
+
+// --- Chiffrement en flux (mémoire constante) ---
+
+// Contexte de chiffrement de Vigenère en flux. La position dans la clé est
+// conservée d'un morceau à l'autre : découper l'entrée n'importe où (même au
+// milieu d'un mot) donne le même résultat qu'un chiffrement d'un seul tenant.
+typedef struct {
+    const uint8_t* shifts; // Décalages de la clé compilée (non possédés)
+    size_t period;         // Nombre de lettres de la clé
+    size_t key_pos;        // Position courante dans la clé
+} VigenereStream;
+
+/**
+ * @brief Initialise un contexte de chiffrement de Vigenère en flux.
+ * La clé compilée doit rester valide jusqu'à vigenere_stream_final().
+ * @param ctx Le contexte à initialiser.
+ * @param key La clé compilée par compile_vigenere_key().
+ * @param decrypt 0 pour chiffrer, 1 pour déchiffrer.
+ */
+void vigenere_stream_init(VigenereStream* ctx, const VigenereKey* key, int decrypt) {
+    ctx->shifts = decrypt ? key->inv_shifts : key->shifts;
+    ctx->period = key->length;
+    ctx->key_pos = 0;
+}
+
+/**
+ * @brief Chiffre un morceau du flux (aucune allocation, in == out autorisé).
+ * @param ctx Le contexte initialisé par vigenere_stream_init().
+ * @param in Le morceau à traiter.
+ * @param len Le nombre d'octets du morceau.
+ * @param out Le tampon de sortie (au moins 'len' octets).
+ */
+void vigenere_stream_update(VigenereStream* ctx, const char* in, size_t len, char* out) {
+    vigenere_apply(ctx->shifts, ctx->period, &ctx->key_pos, in, out, len);
+}
+
+/**
+ * @brief Termine le flux. Vigenère ne retenant aucun octet, rien n'est à vider.
+ * @param ctx Le contexte à terminer.
+ * @return Le nombre d'octets restant à écrire (toujours 0).
+ */
+size_t vigenere_stream_final(VigenereStream* ctx) {
+    ctx->key_pos = 0;
+    return 0;
+}
+
+/**
+ * @brief Écrit l'intégralité d'un tampon sur un descripteur (gère les écritures partielles).
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+static int write_all(int fd, const char* buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Chiffre tout le contenu d'un descripteur vers un autre, par tampons de taille fixe.
+ * La mémoire utilisée est constante quelle que soit la taille de l'entrée.
+ * @param in_fd Le descripteur source.
+ * @param out_fd Le descripteur destination.
+ * @param key La clé compilée par compile_vigenere_key().
+ * @return 0 en cas de succès, -1 en cas d'erreur d'entrée/sortie.
+ */
+int encrypt_vigenere_fd(int in_fd, int out_fd, const VigenereKey* key) {
+    char buffer[STREAM_BUFFER_SIZE];
+    VigenereStream ctx;
+    vigenere_stream_init(&ctx, key, 0);
+
+    for (;;) {
+        ssize_t n = read(in_fd, buffer, sizeof(buffer));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("Erreur de lecture");
+            return -1;
+        }
+        if (n == 0) break; // Fin du flux
+        vigenere_stream_update(&ctx, buffer, (size_t)n, buffer);
+        if (write_all(out_fd, buffer, (size_t)n) == -1) {
+            perror("Erreur d'écriture");
+            return -1;
+        }
+    }
+    vigenere_stream_final(&ctx);
+    return 0;
+}
+
+// --- Exécution parallèle ---
+
+/**
+ * @brief Choisit le nombre de threads pour 'work_items' tâches indépendantes.
+ * @return Le nombre de cœurs disponibles, borné par le nombre de tâches (au moins 1).
+ */
+static unsigned worker_count(size_t work_items) {
+    unsigned thread_count = std::thread::hardware_concurrency();
+    if (thread_count == 0) thread_count = 1;
+    if (thread_count > work_items) thread_count = work_items > 0 ? (unsigned)work_items : 1;
+    return thread_count;
+}
+
+/**
+ * @brief Exécute worker(0) ... worker(thread_count - 1) en parallèle.
+ * Le thread appelant exécute worker(0). Si un thread ne peut être créé
+ * (std::system_error), les indices restants sont exécutés par le thread
+ * appelant : chaque indice est exécuté exactement une fois et les threads déjà
+ * lancés sont toujours attendus. Les workers se partageant le travail par
+ * compteur atomique, un worker exécuté en retard trouve simplement moins de tâches.
+ */
+template <typename F>
+static void run_workers(unsigned thread_count, F worker) {
+    std::vector<std::thread> threads;
+    unsigned started = 1;
+    try {
+        threads.reserve(thread_count - 1);
+        for (; started < thread_count; started++) {
+            threads.emplace_back(worker, started);
+        }
+    } catch (const std::exception&) {
+        // Plus de threads (ou de mémoire) disponibles : le thread appelant fait le reste
+    }
+    worker(0u);
+    for (unsigned t = started; t < thread_count; t++) {
+        worker(t);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+// --- Traitement par lots ---
+
+// Message d'un lot : une tranche de l'arène d'entrée et sa propre clé, elle-même
+// une tranche de l'arène des clés. Le résultat est écrit à la même position
+// dans l'arène de sortie.
+typedef struct {
+    size_t offset;     // Position du message dans l'arène
+    size_t length;     // Nombre d'octets du message
+    size_t key_offset; // Position de la clé dans l'arène des clés
+    size_t key_length; // Nombre d'octets de la clé
+} VigenereRecord;
+
+/**
+ * @brief Chiffre (ou déchiffre) un lot de messages courts, chacun avec sa propre clé.
+ *
+ * Les messages sont lus dans une même arène contiguë et écrits dans une arène
+ * de sortie de même disposition, sans strlen ni allocation par message :
+ * chaque thread compile les clés dans son propre tampon de décalages, réutilisé
+ * d'un message à l'autre (et conservé tel quel si deux messages consécutifs
+ * partagent la même clé). Les enregistrements sont distribués par paquets de
+ * BATCH_CHUNK entre les threads.
+ *
+ * @param in_arena L'arène contenant les messages.
+ * @param out_arena L'arène de sortie (même taille ; in_arena == out_arena autorisé).
+ * @param key_arena L'arène contenant les clés.
+ * @param records Les messages à traiter.
+ * @param count Le nombre de messages.
+ * @param decrypt 0 pour chiffrer, 1 pour déchiffrer.
+ * @return 0 en cas de succès, -1 si une clé ne contient aucune lettre ou en cas d'erreur
+ *         d'allocation (le message concerné est alors recopié tel quel).
+ */
+int encrypt_vigenere_batch(const char* in_arena, char* out_arena, const char* key_arena,
+                           const VigenereRecord* records, size_t count, int decrypt) {
+    std::atomic<int> empty_key(0);
+    std::atomic<int> allocation_failed(0);
+    std::atomic<size_t> next_record(0);
+    auto worker = [&](unsigned) {
+        uint8_t* shifts = NULL;
+        size_t capacity = 0;
+        const char* current_key = NULL; // Clé actuellement compilée dans 'shifts'
+        size_t current_length = 0;
+        size_t period = 0;
+        for (size_t first = next_record.fetch_add(BATCH_CHUNK); first < count;
+             first = next_record.fetch_add(BATCH_CHUNK)) {
+            size_t last = first + BATCH_CHUNK < count ? first + BATCH_CHUNK : count;
+            for (size_t r = first; r < last; r++) {
+                const VigenereRecord* record = &records[r];
+                const char* in = in_arena + record->offset;
+                char* out = out_arena + record->offset;
+                const char* key_text = key_arena + record->key_offset;
+                if (key_text != current_key || record->key_length != current_length) {
+                    if (record->key_length + VIGENERE_KEY_PADDING > capacity) {
+                        uint8_t* grown = (uint8_t*)realloc(shifts, record->key_length + VIGENERE_KEY_PADDING);
+                        if (grown == NULL) {
+                            // errno est propre au thread : le message est affiché ici, une seule fois
+                            if (allocation_failed.exchange(1) == 0) {
+                                perror("Échec de l'allocation mémoire pour la clé");
+                            }
+                            memmove(out, in, record->length);
+                            current_key = NULL;
+                            continue;
+                        }
+                        shifts = grown;
+                        capacity = record->key_length + VIGENERE_KEY_PADDING;
+                    }
+                    period = fill_vigenere_shifts(key_text, record->key_length, decrypt, shifts);
+                    current_key = key_text;
+                    current_length = record->key_length;
+                }
+                if (period == 0) {
+                    empty_key = 1;
+                    memmove(out, in, record->length);
+                    continue;
+                }
+                size_t key_pos = 0;
+                vigenere_apply(shifts, period, &key_pos, in, out, record->length);
+            }
+        }
+        free(shifts);
+    };
+    size_t chunks = (count + BATCH_CHUNK - 1) / BATCH_CHUNK;
+    unsigned thread_count = worker_count(chunks);
+    run_workers(thread_count, worker); // Le thread appelant participe aussi
+
+    if (empty_key) {
+        fprintf(stderr, "Erreur: Au moins une clé du lot ne contient aucun caractère alphabétique valide.\n");
+    }
+    return empty_key || allocation_failed ? -1 : 0;
+}
+
+// --- Cryptanalyse : estimation de la longueur de clé ---
+
+// Longueur de clé candidate et ses indicateurs
+typedef struct {
+    size_t period;   // Longueur de clé candidate
+    double ic;       // IC moyen des colonnes (test de Friedman)
+    double kasiski;  // Part des répétitions dont le PGCD des distances est multiple de la période
+    double score;    // Score combiné (plus élevé = plus probable)
+} KeyLengthCandidate;
+
+/**
+ * @brief Extrait les lettres d'un texte sous forme d'indices 0-25 (casse ignorée).
+ * @param text Le texte source.
+ * @param len Le nombre d'octets du texte.
+ * @param letters Le tampon de sortie (au moins 'len' octets).
+ * @return Le nombre de lettres extraites.
+ */
+static size_t extract_letters(const char* text, size_t len, uint8_t* letters) {
+    size_t n = 0;
+    for (size_t i = 0; i < len; i++) {
+        unsigned letter = ((unsigned char)text[i] | 0x20) - 'a';
+        if (letter < ALPHABET_SIZE) {
+            letters[n++] = (uint8_t)letter;
+        }
+    }
+    return n;
+}
+
+// --- Transposition en colonnes (cosets) ---
+// Les analyses périodiques travaillent colonne par colonne : la colonne c
+// regroupe les lettres de rang c, c + P, c + 2P... Les colonnes sont écrites
+// de façon contiguë dans un même tampon, la colonne c commençant à c * stride,
+// pour que les histogrammes par colonne parcourent une mémoire contiguë.
+
+/**
+ * @brief Nombre de lettres de la colonne 'c' pour 'n' lettres réparties sur 'period' colonnes.
+ */
+static inline size_t coset_length(size_t n, size_t period, size_t c) {
+    return n / period + (c < n % period);
+}
+
+/**
+ * @brief Disperse un bloc de lettres dans les colonnes.
+ * Le bloc commence à une lettre de rang multiple de la période ('row' = rang / période) :
+ * sa lettre j va dans la colonne j % period. Les lectures restent dans le bloc
+ * (en cache) et chaque colonne reçoit une suite d'écritures contiguës.
+ */
+static void scatter_coset_block(const uint8_t* block, size_t m, size_t period, size_t row,
+                                uint8_t* columns, size_t stride) {
+    for (size_t c = 0; c < period && c < m; c++) {
+        uint8_t* dst = columns + c * stride + row;
+        for (size_t j = c; j < m; j += period) {
+            *dst++ = block[j];
+        }
+    }
+}
+
+/**
+ * @brief Taille de bloc (multiple de la période) utilisée par la transposition.
+ */
+static inline size_t coset_block_size(size_t period) {
+    return period >= COSET_BLOCK ? period : (COSET_BLOCK / period) * period;
+}
+
+/**
+ * @brief Transpose une suite de lettres en 'period' colonnes contiguës, par blocs.
+ * @param letters Les lettres (indices 0-25).
+ * @param n Le nombre de lettres.
+ * @param period Le nombre de colonnes.
+ * @param columns Le tampon de sortie (au moins period * stride octets).
+ * @param stride L'écart entre deux colonnes (au moins ceil(n / period)).
+ */
+void transpose_cosets(const uint8_t* letters, size_t n, size_t period, uint8_t* columns, size_t stride) {
+    size_t block = coset_block_size(period);
+    for (size_t base = 0; base < n; base += block) {
+        size_t m = n - base < block ? n - base : block;
+        scatter_coset_block(letters + base, m, period, base / period, columns, stride);
+    }
+}
+
+/**
+ * @brief Extrait les lettres d'un texte et les répartit en 'period' colonnes contiguës, en une passe.
+ *
+ * Les non-lettres sont supprimées et la casse ignorée. Les lettres sont
+ * accumulées dans un bloc qui tient en cache, puis dispersées colonne par colonne.
+ *
+ * @param text Le texte source.
+ * @param len Le nombre d'octets du texte.
+ * @param period Le nombre de colonnes.
+ * @param columns Le tampon de sortie (au moins period * stride octets).
+ * @param stride L'écart entre deux colonnes (len / period + 1 suffit toujours).
+ * @return Le nombre total de lettres, ou 0 en cas d'erreur d'allocation.
+ */
+size_t deinterleave_letters(const char* text, size_t len, size_t period, uint8_t* columns, size_t stride) {
+    size_t block_size = coset_block_size(period);
+    uint8_t* block = (uint8_t*)malloc(block_size);
+    if (block == NULL) {
+        perror("Échec de l'allocation mémoire pour la transposition");
+        return 0;
+    }
+
+    size_t n = 0; // Lettres déjà dispersées
+    size_t m = 0; // Lettres dans le bloc courant
+    for (size_t i = 0; i < len; i++) {
+        unsigned letter = ((unsigned char)text[i] | 0x20) - 'a';
+        if (letter < ALPHABET_SIZE) {
+            block[m++] = (uint8_t)letter;
+            if (m == block_size) {
+                scatter_coset_block(block, m, period, n / period, columns, stride);
+                n += m;
+                m = 0;
+            }
+        }
+    }
+    scatter_coset_block(block, m, period, n / period, columns, stride);
+    free(block);
+    return n + m;
+}
+
+/**
+ * @brief Calcule l'histogramme d'une colonne contiguë.
+ */
+static void column_histogram(const uint8_t* column, size_t len, size_t counts[ALPHABET_SIZE]) {
+    for (int l = 0; l < ALPHABET_SIZE; l++) {
+        counts[l] = 0;
+    }
+    for (size_t i = 0; i < len; i++) {
+        counts[column[i]]++;
+    }
+}
 
 /**
- * @brief Chiffre un texte en clair en utilisant le chiffrement de Vigenère.
+ * @brief Calcule l'IC moyen des colonnes obtenues en découpant le texte selon une période.
+ * @param letters Les lettres du texte (indices 0-25).
+ * @param n Le nombre de lettres.
+ * @param period La période candidate.
+ * @param columns Tampon de travail d'au moins n + period octets.
+ * @return L'IC moyen des 'period' colonnes.
+ */
+static double average_column_ic(const uint8_t* letters, size_t n, size_t period, uint8_t* columns) {
+    size_t stride = n / period + 1;
+    transpose_cosets(letters, n, period, columns, stride);
+
+    double sum = 0.0;
+    for (size_t c = 0; c < period; c++) {
+        size_t column_len = coset_length(n, period, c);
+        if (column_len < 2) continue;
+        size_t counts[ALPHABET_SIZE];
+        column_histogram(columns + c * stride, column_len, counts);
+        double ic = 0.0;
+        for (int l = 0; l < ALPHABET_SIZE; l++) {
+            double k = (double)counts[l];
+            ic += k * (k - 1);
+        }
+        sum += ic / ((double)column_len * (column_len - 1));
+    }
+    return sum / period;
+}
+
+/**
+ * @brief Histogramme des PGCD des distances entre répétitions (Kasiski), par tableau des suffixes.
  *
- * Alloue dynamiquement de la mémoire pour le texte chiffré.
- * L'appelant est responsable de libérer cette mémoire avec free().
+ * Les suffixes sont triés sur leurs 'min_length' premières lettres : deux
+ * voisins du tableau ont un plus long préfixe commun (LCP) d'au moins
+ * min_length si et seulement si leurs clés de tri sont égales. Chaque série de
+ * voisins de LCP >= min_length rassemble toutes les occurrences d'une même
+ * répétition, déjà rangées par position croissante ; le PGCD de leurs distances
+ * est ajouté à l'histogramme. Le tri se fait en deux temps : un tri par
+ * comptage (stable) sur les 4 premières lettres, puis le tri des seaux sur la
+ * suite de la clé, réparti entre les threads. Profondeur bornée et seaux
+ * indépendants gardent le coût quasi linéaire, même sur plusieurs dizaines de
+ * mégaoctets.
  *
- * @param plaintext Le texte en clair à chiffrer.
- * @param key La clé de chiffrement.
- * @return Un pointeur vers la chaîne de caractères chiffrée, ou NULL en cas d'erreur.
+ * Toutes les répétitions d'au moins KASISKI_MIN_LENGTH lettres sont comptées
+ * par défaut. Sur un long texte, environ n^2 / (2 * 26^L) d'entre elles sont
+ * fortuites ; leurs votes se dispersent, mais l'appelant peut les écarter en
+ * demandant explicitement une longueur minimale plus grande.
+ *
+ * @param letters Les lettres du texte (indices 0-25).
+ * @param n Le nombre de lettres.
+ * @param min_length La longueur minimale des répétitions (0 : KASISKI_MIN_LENGTH).
+ * @param max_gcd Le plus grand PGCD compté dans l'histogramme.
+ * @param histogram Reçoit, pour g dans 1..max_gcd, le nombre de répétitions dont les distances ont pour PGCD g (max_gcd + 1 éléments).
+ * @return Le nombre total de répétitions trouvées (y compris celles de PGCD > max_gcd), 0 en cas d'erreur.
  */
-char* encrypt_vigenere(const char* plaintext, const char* key) {
-    size_t plain_len = strlen(plaintext);
-    size_t key_len = strlen(key);
-
-    // Alloue de la mémoire pour le texte chiffré (+1 pour le caractère nul de fin de chaîne)
-    char* ciphertext = (char*)malloc((plain_len + 1) * sizeof(char));
-    if (ciphertext == NULL) {
-        perror("Échec de l'allocation mémoire pour le texte chiffré");
-        return NULL;
+static size_t kasiski_gcd_histogram(const uint8_t* letters, size_t n, size_t min_length, size_t max_gcd,
+                                    size_t* histogram) {
+    for (size_t g = 0; g <= max_gcd; g++) {
+        histogram[g] = 0;
+    }
+    if (min_length == 0) min_length = KASISKI_MIN_LENGTH;
+    if (min_length < 2) min_length = 2;
+    if (min_length > KASISKI_MAX_LENGTH) min_length = KASISKI_MAX_LENGTH;
+    if (n < min_length + 1 || n > UINT32_MAX) {
+        return 0;
+    }
+    // Tri par comptage des suffixes sur leurs 'prefix' premières lettres
+    size_t prefix = min_length < 4 ? min_length : 4;
+    // La suite de la clé partage un entier de 64 bits avec la position du suffixe
+    unsigned position_bits = 1;
+    while (position_bits < 32 && ((size_t)1 << position_bits) < n) position_bits++;
+    size_t max_length = prefix;
+    for (double power = ALPHABET_SIZE; power < ldexp(1.0, 64 - position_bits); power *= ALPHABET_SIZE) max_length++;
+    if (min_length > max_length) min_length = max_length;
+    size_t suffixes = n - min_length + 1; // Suffixes d'au moins min_length lettres
+    size_t bucket_count = 1;
+    for (size_t i = 0; i < prefix; i++) bucket_count *= ALPHABET_SIZE;
+    uint32_t* starts = (uint32_t*)calloc(bucket_count + 1, sizeof(uint32_t));
+    uint32_t* suffix_array = (uint32_t*)malloc(suffixes * sizeof(uint32_t));
+    if (starts == NULL || suffix_array == NULL) {
+        perror("Échec de l'allocation mémoire pour l'analyse");
+        free(starts); free(suffix_array);
+        return 0;
+    }
+    auto bucket_of = [&](size_t i) {
+        size_t b = 0;
+        for (size_t k = 0; k < prefix; k++) b = b * ALPHABET_SIZE + letters[i + k];
+        return b;
+    };
+    for (size_t i = 0; i < suffixes; i++) starts[bucket_of(i) + 1]++;
+    for (size_t b = 0; b < bucket_count; b++) starts[b + 1] += starts[b];
+    {
+        uint32_t* fill = (uint32_t*)malloc(bucket_count * sizeof(uint32_t));
+        if (fill == NULL) {
+            perror("Échec de l'allocation mémoire pour l'analyse");
+            free(starts); free(suffix_array);
+            return 0;
+        }
+        memcpy(fill, starts, bucket_count * sizeof(uint32_t));
+        for (size_t i = 0; i < suffixes; i++) suffix_array[fill[bucket_of(i)]++] = (uint32_t)i;
+        free(fill);
     }
 
-    int key_idx = 0; // Index pour parcourir la clé
+    unsigned thread_count = worker_count(bucket_count);
+    // Clés de tri : une tranche par thread, de la taille du plus grand seau
+    size_t largest_bucket = 0;
+    if (min_length > prefix) {
+        for (size_t b = 0; b < bucket_count; b++) {
+            size_t size = starts[b + 1] - starts[b];
+            if (size > largest_bucket) largest_bucket = size;
+        }
+    }
+    size_t* local_histograms = (size_t*)calloc(thread_count * (max_gcd + 1), sizeof(size_t));
+    size_t* local_repeats = (size_t*)calloc(thread_count, sizeof(size_t));
+    uint64_t* local_keys = (uint64_t*)malloc((thread_count * largest_bucket + 1) * sizeof(uint64_t));
+    if (local_histograms == NULL || local_repeats == NULL || local_keys == NULL) {
+        perror("Échec de l'allocation mémoire pour l'analyse");
+        free(starts); free(suffix_array); free(local_histograms); free(local_repeats); free(local_keys);
+        return 0;
+    }
 
-    for (size_t i = 0; i < plain_len; i++) {
-        char plain_char = plaintext[i];
-        char encrypted_char;
+    // Les seaux sont distribués par paquets entre les threads
+    const size_t chunk = 256;
+    const uint64_t position_mask = ((uint64_t)1 << position_bits) - 1;
+    std::atomic<size_t> next_bucket(0);
+    auto worker = [&](unsigned id) {
+        size_t* hist = local_histograms + id * (max_gcd + 1);
+        size_t repeats = 0;
+        uint64_t* keys = local_keys + id * largest_bucket; // Lettres prefix..min_length-1 en base 26, suivies de la position
+        for (size_t first = next_bucket.fetch_add(chunk); first < bucket_count; first = next_bucket.fetch_add(chunk)) {
+            size_t last = first + chunk < bucket_count ? first + chunk : bucket_count;
+            for (size_t b = first; b < last; b++) {
+                uint32_t* bucket = suffix_array + starts[b];
+                size_t size = starts[b + 1] - starts[b];
+                if (size < 2) continue;
 
-        if (isalpha(plain_char)) { // Traite uniquement les caractères alphabétiques
-            char base = isupper(plain_char) ? 'A' : 'a'; // Détermine la base ('A' ou 'a')
-            
-            // Cherche le prochain caractère alphabétique dans la clé
-            // Boucle pour ignorer les non-alphabétiques dans la clé
-            while (key_idx < key_len && !isalpha(key[key_idx])) {
-                key_idx++;
-            }
-            // Si on a parcouru toute la clé, recommence au début
-            if (key_idx == key_len) {
-                key_idx = 0;
-                // Assure qu'on ne boucle pas indéfiniment si la clé ne contient que des non-alphabétiques
-                while (key_idx < key_len && !isalpha(key[key_idx])) {
-                    key_idx++;
+                // Trie le seau sur la suite de la clé ; à clé égale, par position croissante
+                if (min_length > prefix) {
+                    for (size_t i = 0; i < size; i++) {
+                        uint64_t key = 0;
+                        for (size_t k = prefix; k < min_length; k++) key = key * ALPHABET_SIZE + letters[bucket[i] + k];
+                        keys[i] = (key << position_bits) | bucket[i];
+                    }
+                    std::sort(keys, keys + size);
+                    for (size_t i = 0; i < size; i++) bucket[i] = (uint32_t)(keys[i] & position_mask);
                 }
-                // Si la clé est vide ou ne contient que des non-alphabétiques, on ne peut pas chiffrer
-                if (key_idx == key_len) { 
-                    fprintf(stderr, "Erreur: La clé ne contient aucun caractère alphabétique valide.\n");
-                    free(ciphertext);
-                    return NULL;
+
+                // Séries de voisins de LCP >= min_length : PGCD des distances successives
+                size_t run_start = 0;
+                for (size_t i = 1; i <= size; i++) {
+                    int same = i < size && (min_length == prefix || (keys[i] >> position_bits) == (keys[i - 1] >> position_bits));
+                    if (same) continue;
+                    if (i - run_start >= 2) {
+                        size_t g = 0;
+                        for (size_t j = run_start + 1; j < i; j++) {
+                            size_t d = bucket[j] - bucket[j - 1];
+                            while (d != 0) { size_t r = g % d; g = d; d = r; }
+                        }
+                        repeats++;
+                        if (g <= max_gcd) hist[g]++;
+                    }
+                    run_start = i;
                 }
             }
+        }
+        local_repeats[id] = repeats;
+    };
+    run_workers(thread_count, worker); // Le thread appelant participe aussi
 
-            char key_char_for_shift = toupper(key[key_idx]); // Utilise la majuscule de la clé pour le décalage
-            int shift = key_char_for_shift - 'A'; // Calcule la valeur de décalage (0-25)
+    size_t repeats = 0;
+    for (unsigned t = 0; t < thread_count; t++) {
+        repeats += local_repeats[t];
+        for (size_t g = 1; g <= max_gcd; g++) histogram[g] += local_histograms[t * (max_gcd + 1) + g];
+    }
+    free(starts);
+    free(suffix_array);
+    free(local_histograms);
+    free(local_repeats);
+    free(local_keys);
+    return repeats;
+}
 
-            // Applique la formule de chiffrement de Vigenère
-            encrypted_char = ((plain_char - base + shift) % 26) + base;
-            
-            key_idx++; // Passe au caractère suivant de la clé pour le prochain chiffrement
-        } else {
-            // Les caractères non alphabétiques sont laissés inchangés
-            encrypted_char = plain_char;
+/**
+ * @brief Compare deux candidats par score décroissant (pour qsort).
+ */
+static int compare_key_length_candidates(const void* a, const void* b) {
+    double sa = ((const KeyLengthCandidate*)a)->score;
+    double sb = ((const KeyLengthCandidate*)b)->score;
+    return (sa < sb) - (sa > sb);
+}
+
+/**
+ * @brief Estime la longueur de la clé d'un texte chiffré par Vigenère.
+ *
+ * Pour chaque période candidate 1..max_period, le texte est découpé en colonnes
+ * dont l'IC moyen est calculé (test de Friedman) ; les périodes sont réparties
+ * entre plusieurs threads. Un test de Kasiski sur les répétitions du texte
+ * (kasiski_gcd_histogram) départage la vraie période de ses multiples, qui ont
+ * un IC comparable mais divisent moins de PGCD de distances.
+ *
+ * @param ciphertext Le texte chiffré.
+ * @param len Le nombre d'octets du texte chiffré.
+ * @param max_period La plus grande longueur de clé envisagée.
+ * @param ranked Reçoit les périodes classées de la plus à la moins probable (au moins max_period éléments).
+ * @return Le nombre de périodes classées (celles laissant au moins 2 lettres par colonne), 0 en cas d'erreur.
+ */
+size_t estimate_vigenere_key_length(const char* ciphertext, size_t len, size_t max_period,
+                                    KeyLengthCandidate* ranked) {
+    uint8_t* letters = (uint8_t*)malloc(len > 0 ? len : 1);
+    if (letters == NULL) {
+        perror("Échec de l'allocation mémoire pour l'analyse");
+        return 0;
+    }
+    size_t n = extract_letters(ciphertext, len, letters);
+    if (max_period > n / 2) {
+        max_period = n / 2; // Au moins 2 lettres par colonne
+    }
+    if (max_period == 0) {
+        free(letters);
+        return 0;
+    }
+
+    size_t* votes = (size_t*)malloc((max_period + 1) * sizeof(size_t));
+    if (votes == NULL) {
+        perror("Échec de l'allocation mémoire pour l'analyse");
+        free(letters);
+        return 0;
+    }
+    // Test de Kasiski : une répétition vote pour chaque diviseur du PGCD de ses distances
+    size_t max_gcd = n < KASISKI_MAX_GCD ? n : KASISKI_MAX_GCD;
+    size_t* gcd_histogram = (size_t*)malloc((max_gcd + 1) * sizeof(size_t));
+    if (gcd_histogram == NULL) {
+        perror("Échec de l'allocation mémoire pour l'analyse");
+        free(votes);
+        free(letters);
+        return 0;
+    }
+    size_t distances = kasiski_gcd_histogram(letters, n, 0, max_gcd, gcd_histogram);
+    for (size_t p = 1; p <= max_period; p++) {
+        votes[p] = 0;
+        for (size_t g = p; g <= max_gcd; g += p) votes[p] += gcd_histogram[g];
+    }
+    free(gcd_histogram);
+
+    // Test de Friedman : les périodes sont distribuées dynamiquement entre les threads
+    unsigned thread_count = worker_count(max_period);
+    // Tampons de transposition (un par thread), alloués avant de lancer les threads
+    uint8_t* scratch = (uint8_t*)malloc(thread_count * (n + max_period));
+    if (scratch == NULL) {
+        perror("Échec de l'allocation mémoire pour l'analyse");
+        free(votes);
+        free(letters);
+        return 0;
+    }
+    std::atomic<size_t> next_period(1);
+    auto worker = [&](unsigned t) {
+        uint8_t* columns = scratch + t * (n + max_period);
+        for (size_t p = next_period++; p <= max_period; p = next_period++) {
+            double ic = average_column_ic(letters, n, p, columns);
+            double kasiski = distances > 0 ? (double)votes[p] / distances : 0.0;
+            double ic_score = (ic - RANDOM_IC) / (FRENCH_IC - RANDOM_IC);
+            ranked[p - 1].period = p;
+            ranked[p - 1].ic = ic;
+            ranked[p - 1].kasiski = kasiski;
+            // La période 1 divise toutes les distances : son vote Kasiski n'apporte rien
+            ranked[p - 1].score = ic_score + (p > 1 ? 0.5 * kasiski : 0.0);
         }
-        ciphertext[i] = encrypted_char;
+    };
+    run_workers(thread_count, worker); // Le thread appelant participe aussi
+
+    qsort(ranked, max_period, sizeof(KeyLengthCandidate), compare_key_length_candidates);
+    free(scratch);
+    free(votes);
+    free(letters);
+    return max_period;
+}
+
+// --- Cryptanalyse : autocorrélation des coïncidences (FFT) ---
+
+/**
+ * @brief Précalcule les facteurs de rotation de chaque étage d'une FFT de taille size.
+ * Les facteurs de l'étage de longueur 'half' sont rangés de façon contiguë :
+ * twiddle[half + k] = exp(-i*pi*k/half), k < half (size - 1 éléments utiles).
+ */
+static void fill_twiddles(double* twiddle_re, double* twiddle_im, size_t size) {
+    size_t last = size / 2;
+    for (size_t k = 0; k < last; k++) {
+        twiddle_re[last + k] = cos(-M_PI * k / last);
+        twiddle_im[last + k] = sin(-M_PI * k / last);
     }
-    ciphertext[plain_len] = '\0'; // Termine la chaîne avec un caractère nul
+    // Les étages précédents sous-échantillonnent le dernier
+    for (size_t half = last / 2; half >= 1; half /= 2) {
+        for (size_t k = 0; k < half; k++) {
+            twiddle_re[half + k] = twiddle_re[last + k * (last / half)];
+            twiddle_im[half + k] = twiddle_im[last + k * (last / half)];
+        }
+    }
+}
 
-    return ciphertext;
+/**
+ * @brief FFT radix 2 à décimation en fréquence : entrée en ordre naturel, sortie en ordre de bits inversés.
+ * Les derniers étages travaillent sur des blocs contigus de FFT_CACHE_BLOCK
+ * points : ils sont enchaînés bloc par bloc tant que le bloc tient en cache, au
+ * lieu de parcourir tout le tableau à chaque étage.
+ * @param re Parties réelles (size éléments).
+ * @param im Parties imaginaires (size éléments).
+ * @param size La taille, puissance de 2.
+ * @param twiddle_re Les facteurs par étage (voir fill_twiddles), parties réelles.
+ * @param twiddle_im Les facteurs par étage, parties imaginaires.
+ */
+static void fft_dif(double* re, double* im, size_t size, const double* twiddle_re, const double* twiddle_im) {
+    auto stage = [&](size_t begin, size_t end, size_t half) {
+        const double* wre = twiddle_re + half;
+        const double* wim = twiddle_im + half;
+        for (size_t start = begin; start < end; start += 2 * half) {
+            for (size_t k = 0; k < half; k++) {
+                size_t a = start + k, b = a + half;
+                double dr = re[a] - re[b], di = im[a] - im[b];
+                re[a] += re[b]; im[a] += im[b];
+                re[b] = dr * wre[k] - di * wim[k];
+                im[b] = dr * wim[k] + di * wre[k];
+            }
+        }
+    };
+    size_t block = size < FFT_CACHE_BLOCK ? size : FFT_CACHE_BLOCK;
+    for (size_t half = size / 2; half >= block; half /= 2) {
+        stage(0, size, half);
+    }
+    for (size_t begin = 0; begin < size; begin += block) {
+        for (size_t half = block / 2; half >= 1; half /= 2) {
+            stage(begin, begin + block, half);
+        }
+    }
 }
 
 /**
- * @brief Déchiffre un texte chiffré en utilisant le chiffrement de Vigenère.
+ * @brief FFT radix 2 à décimation en temps : entrée en ordre de bits inversés, sortie en ordre naturel.
+ * Enchaînée après fft_dif, aucune permutation des bits inversés n'est nécessaire.
+ * Mêmes paramètres que fft_dif ; les premiers étages sont traités bloc par bloc.
+ */
+static void fft_dit(double* re, double* im, size_t size, const double* twiddle_re, const double* twiddle_im) {
+    auto stage = [&](size_t begin, size_t end, size_t half) {
+        const double* wre = twiddle_re + half;
+        const double* wim = twiddle_im + half;
+        for (size_t start = begin; start < end; start += 2 * half) {
+            for (size_t k = 0; k < half; k++) {
+                size_t a = start + k, b = a + half;
+                double xr = re[b] * wre[k] - im[b] * wim[k];
+                double xi = re[b] * wim[k] + im[b] * wre[k];
+                re[b] = re[a] - xr; im[b] = im[a] - xi;
+                re[a] += xr; im[a] += xi;
+            }
+        }
+    };
+    size_t block = size < FFT_CACHE_BLOCK ? size : FFT_CACHE_BLOCK;
+    for (size_t begin = 0; begin < size; begin += block) {
+        for (size_t half = 1; half < block; half <<= 1) {
+            stage(begin, begin + block, half);
+        }
+    }
+    for (size_t half = block; half < size; half <<= 1) {
+        stage(0, size, half);
+    }
+}
+
+/**
+ * @brief Calcule le taux de coïncidence d'un texte avec lui-même décalé, pour tous les décalages.
  *
- * Alloue dynamiquement de la mémoire pour le texte déchiffré.
- * L'appelant est responsable de libérer cette mémoire avec free().
+ * Avec w = exp(2*i*pi/26), la somme des w^(j*(a-b)) pour j = 0..25 vaut 26 si
+ * a = b et 0 sinon : le nombre de coïncidences au décalage k est donc, au
+ * facteur 1/26 près, la somme des autocorrélations des signaux z_j = w^(j*l_i).
+ * Elles s'obtiennent pour tous les k à la fois par FFT : les spectres de
+ * puissance sont cumulés puis retransformés une seule fois. z_0 est constant
+ * et z_(26-j) est le conjugué de z_j, si bien que 13 FFT (j = 1..13, réparties
+ * entre les threads) suffisent, en O(n log n) au lieu de O(n^2). Le spectre de
+ * puissance ne dépend pas de l'ordre des fréquences : la FFT directe laisse sa
+ * sortie en ordre de bits inversés, que la FFT inverse prend telle quelle.
  *
- * @param ciphertext Le texte chiffré à déchiffrer.
- * @param key La clé de déchiffrement (doit être la même que celle utilisée pour le chiffrement).
- * @return Un pointeur vers la chaîne de caractères déchiffrée, ou NULL en cas d'erreur.
+ * @param text Le texte (les non-lettres sont ignorées).
+ * @param len Le nombre d'octets du texte.
+ * @param max_shift Le plus grand décalage calculé.
+ * @param rates Reçoit, pour k dans 0..max_shift, coïncidences / (n - k) (max_shift + 1 éléments, 0 au-delà de n - 1).
+ * @return Le nombre de lettres du texte, 0 en cas d'erreur.
  */
-char* decrypt_vigenere(const char* ciphertext, const char* key) {
-    size_t cipher_len = strlen(ciphertext);
-    size_t key_len = strlen(key);
+size_t coincidence_autocorrelation(const char* text, size_t len, size_t max_shift, double* rates) {
+    uint8_t* letters = (uint8_t*)malloc(len > 0 ? len : 1);
+    if (letters == NULL) {
+        perror("Échec de l'allocation mémoire pour l'analyse");
+        return 0;
+    }
+    size_t n = extract_letters(text, len, letters);
+    if (n == 0) {
+        free(letters);
+        return 0;
+    }
 
-    // Alloue de la mémoire pour le texte clair (+1 pour le caractère nul de fin de chaîne)
-    char* plaintext = (char*)malloc((cipher_len + 1) * sizeof(char));
-    if (plaintext == NULL) {
-        perror("Échec de l'allocation mémoire pour le texte clair");
-        return NULL;
+    // Taille de FFT >= 2n pour éviter le repliement circulaire
+    size_t size = 2;
+    while (size < 2 * n) size <<= 1;
+    const unsigned harmonics = ALPHABET_SIZE / 2;
+    unsigned thread_count = worker_count(harmonics);
+
+    // Facteurs de rotation, puis pour chaque thread : signal (re, im) et spectre cumulé
+    double* twiddle = (double*)malloc(2 * size * sizeof(double));
+    double* work = (double*)malloc(thread_count * 3 * size * sizeof(double));
+    if (twiddle == NULL || work == NULL) {
+        perror("Échec de l'allocation mémoire pour l'analyse");
+        free(letters); free(twiddle); free(work);
+        return 0;
+    }
+    double* twiddle_re = twiddle;
+    double* twiddle_im = twiddle + size;
+    fill_twiddles(twiddle_re, twiddle_im, size);
+    double roots_re[ALPHABET_SIZE], roots_im[ALPHABET_SIZE];
+    for (int l = 0; l < ALPHABET_SIZE; l++) {
+        roots_re[l] = cos(2.0 * M_PI * l / ALPHABET_SIZE);
+        roots_im[l] = sin(2.0 * M_PI * l / ALPHABET_SIZE);
+    }
+
+    std::atomic<unsigned> next_harmonic(1);
+    auto worker = [&](unsigned id) {
+        double* re = work + id * 3 * size;
+        double* im = re + size;
+        double* power = im + size;
+        memset(power, 0, size * sizeof(double));
+        for (unsigned j = next_harmonic++; j <= harmonics; j = next_harmonic++) {
+            for (size_t i = 0; i < n; i++) {
+                unsigned phase = (j * letters[i]) % ALPHABET_SIZE;
+                re[i] = roots_re[phase];
+                im[i] = roots_im[phase];
+            }
+            memset(re + n, 0, (size - n) * sizeof(double));
+            memset(im + n, 0, (size - n) * sizeof(double));
+            fft_dif(re, im, size, twiddle_re, twiddle_im);
+            // z_j et son conjugué z_(26-j) ont la même contribution, sauf pour j = 13
+            double weight = j == harmonics ? 1.0 : 2.0;
+            for (size_t f = 0; f < size; f++) {
+                power[f] += weight * (re[f] * re[f] + im[f] * im[f]);
+            }
+        }
+    };
+    run_workers(thread_count, worker); // Le thread appelant participe aussi
+
+    // Spectre total dans le tampon du thread 0, puis FFT inverse (spectre réel : la
+    // partie réelle de la FFT directe divisée par size donne l'autocorrélation)
+    double* power = work + 2 * size;
+    for (unsigned t = 1; t < thread_count; t++) {
+        const double* other = work + t * 3 * size + 2 * size;
+        for (size_t f = 0; f < size; f++) power[f] += other[f];
+    }
+    double* im = work + size;
+    memset(im, 0, size * sizeof(double));
+    fft_dit(power, im, size, twiddle_re, twiddle_im);
+    for (size_t k = 0; k <= max_shift; k++) {
+        // Le terme j = 0 compte n - k coïncidences fictives (z_0 = 1)
+        rates[k] = k < n ? floor(((double)(n - k) + power[k] / size) / ALPHABET_SIZE + 0.5) / (double)(n - k) : 0.0;
+    }
+    free(letters);
+    free(twiddle);
+    free(work);
+    return n;
+}
+
+/**
+ * @brief Détecte la période d'un chiffrement polyalphabétique par autocorrélation.
+ *
+ * Un texte décalé d'un multiple de la période se superpose à lui-même avec le
+ * même alphabet : son taux de coïncidence est celui de la langue, contre
+ * environ 1/26 ailleurs. Chaque période est notée par le taux moyen de ses
+ * multiples sur la première moitié des décalages (recouvrement d'au moins n/2
+ * lettres) ; les multiples de la vraie période ayant un score comparable, on
+ * retient la plus petite période dont l'excès sur 1/26 atteint 75 % du meilleur.
+ *
+ * @param ciphertext Le texte chiffré.
+ * @param len Le nombre d'octets du texte chiffré.
+ * @param max_period La plus grande période envisagée.
+ * @return La période détectée (1 si aucun score ne dépasse 1/26), 0 en cas d'erreur.
+ */
+size_t detect_period_autocorrelation(const char* ciphertext, size_t len, size_t max_period) {
+    if (max_period == 0) {
+        return 0;
+    }
+    size_t max_shift = len / 2 > max_period ? len / 2 : max_period;
+    double* rates = (double*)malloc((max_shift + 1) * sizeof(double));
+    if (rates == NULL) {
+        perror("Échec de l'allocation mémoire pour l'analyse");
+        return 0;
+    }
+    size_t n = coincidence_autocorrelation(ciphertext, len, max_shift, rates);
+    if (n < 2) {
+        free(rates);
+        return 0;
+    }
+    if (max_shift > n / 2) max_shift = n / 2;
+    if (max_period > max_shift) max_period = max_shift;
+
+    double* scores = (double*)malloc((max_period + 1) * sizeof(double));
+    if (scores == NULL) {
+        perror("Échec de l'allocation mémoire pour l'analyse");
+        free(rates);
+        return 0;
+    }
+    double best = 0.0;
+    for (size_t p = 1; p <= max_period; p++) {
+        double sum = 0.0;
+        size_t multiples = 0;
+        for (size_t k = p; k <= max_shift; k += p) {
+            sum += rates[k];
+            multiples++;
+        }
+        scores[p] = sum / multiples;
+        if (p == 1 || scores[p] > best) best = scores[p];
+    }
+    // Aucun décalage ne dépasse le hasard : pas de période décelable
+    size_t period = 1;
+    if (best > RANDOM_IC) {
+        while (period < max_period && scores[period] - RANDOM_IC < 0.75 * (best - RANDOM_IC)) period++;
     }
+    free(scores);
+    free(rates);
+    return period;
+}
+
+// --- Cryptanalyse : recouvrement de la clé ---
 
-    int key_idx = 0; // Index pour parcourir la clé
+// Fréquences de référence des lettres A-Z en français
+static const double FRENCH_FREQUENCIES[ALPHABET_SIZE] = {
+    0.07636, 0.00901, 0.03260, 0.03669, 0.14715, 0.01066, 0.00866, 0.00737, 0.07529,
+    0.00613, 0.00074, 0.05456, 0.02968, 0.07095, 0.05796, 0.02521, 0.01362, 0.06693,
+    0.07948, 0.07244, 0.06311, 0.01838, 0.00049, 0.00427, 0.00128, 0.00326
+};
 
-    for (size_t i = 0; i < cipher_len; i++) {
-        char cipher_char = ciphertext[i];
-        char decrypted_char;
+// Résultat du cassage d'un texte chiffré par Vigenère
+typedef struct {
+    size_t period;   // Longueur de la clé retrouvée
+    char* key;       // Clé retrouvée en majuscules (allouée dynamiquement)
+    char* plaintext; // Sortie de decrypt_vigenere() avec cette clé (allouée dynamiquement)
+} VigenereCrackResult;
 
-        if (isalpha(cipher_char)) { // Traite uniquement les caractères alphabétiques
-            char base = isupper(cipher_char) ? 'A' : 'a'; // Détermine la base ('A' ou 'a')
+/**
+ * @brief Trouve le décalage d'une colonne (un chiffrement de César) par khi-deux.
+ * @param counts L'histogramme de la colonne.
+ * @param total Le nombre de lettres de la colonne.
+ * @param reference Les fréquences de la langue attendue.
+ * @return Le décalage (0-25) minimisant le khi-deux.
+ */
+static int best_column_shift(const size_t counts[ALPHABET_SIZE], size_t total, const double reference[ALPHABET_SIZE]) {
+    int best_shift = 0;
+    double best_chi2 = -1.0;
+    for (int shift = 0; shift < ALPHABET_SIZE; shift++) {
+        double chi2 = 0.0;
+        for (int l = 0; l < ALPHABET_SIZE; l++) {
+            double expected = total * reference[l];
+            double diff = (double)counts[(l + shift) % ALPHABET_SIZE] - expected;
+            chi2 += diff * diff / expected;
+        }
+        if (best_chi2 < 0.0 || chi2 < best_chi2) {
+            best_chi2 = chi2;
+            best_shift = shift;
+        }
+    }
+    return best_shift;
+}
 
-            // Cherche le prochain caractère alphabétique dans la clé
-            while (key_idx < key_len && !isalpha(key[key_idx])) {
-                key_idx++;
+/**
+ * @brief Affine la clé par indice de coïncidence mutuel entre colonnes.
+ *
+ * Chaque colonne, déchiffrée avec chacun des 26 décalages possibles, est comparée
+ * à l'histogramme cumulé des autres colonnes déchiffrées avec la clé courante ;
+ * le décalage maximisant l'IC mutuel est retenu. Utile sur les textes courts,
+ * où le khi-deux d'une colonne isolée est bruité.
+ *
+ * @param counts Les histogrammes des colonnes ('period' x ALPHABET_SIZE).
+ * @param period La longueur de clé.
+ * @param shifts La clé (décalages) à affiner, modifiée sur place.
+ */
+static void refine_shifts_mutual_ic(const size_t* counts, size_t period, int* shifts) {
+    size_t pooled[ALPHABET_SIZE];
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t j = 0; j < period; j++) {
+            // Histogramme clair cumulé des autres colonnes
+            for (int l = 0; l < ALPHABET_SIZE; l++) pooled[l] = 0;
+            for (size_t c = 0; c < period; c++) {
+                if (c == j) continue;
+                for (int l = 0; l < ALPHABET_SIZE; l++) {
+                    pooled[l] += counts[c * ALPHABET_SIZE + (l + shifts[c]) % ALPHABET_SIZE];
+                }
             }
-            if (key_idx == key_len) {
-                key_idx = 0;
-                while (key_idx < key_len && !isalpha(key[key_idx])) {
-                    key_idx++;
+            int best_shift = shifts[j];
+            double best_mic = -1.0;
+            for (int shift = 0; shift < ALPHABET_SIZE; shift++) {
+                double mic = 0.0;
+                for (int l = 0; l < ALPHABET_SIZE; l++) {
+                    mic += (double)pooled[l] * counts[j * ALPHABET_SIZE + (l + shift) % ALPHABET_SIZE];
                 }
-                if (key_idx == key_len) {
-                    fprintf(stderr, "Erreur: La clé ne contient aucun caractère alphabétique valide.\n");
-                    free(plaintext);
-                    return NULL;
+                if (mic > best_mic) {
+                    best_mic = mic;
+                    best_shift = shift;
                 }
             }
-            
-            char key_char_for_shift = toupper(key[key_idx]); // Utilise la majuscule de la clé pour le décalage
-            int shift = key_char_for_shift - 'A'; // Calcule la valeur de décalage (0-25)
+            shifts[j] = best_shift;
+        }
+    }
+}
 
-            // Applique la formule de déchiffrement de Vigenère
-            // Ajoute +26 avant le modulo pour gérer correctement les résultats négatifs en C
-            decrypted_char = ((cipher_char - base - shift + 26) % 26) + base;
-            
-            key_idx++; // Passe au caractère suivant de la clé
-        } else {
-            // Les caractères non alphabétiques sont laissés inchangés
-            decrypted_char = cipher_char;
+/**
+ * @brief Libère les chaînes d'un résultat de crack_vigenere().
+ * @param result Le résultat à libérer.
+ */
+void free_vigenere_crack_result(VigenereCrackResult* result) {
+    free(result->key);
+    free(result->plaintext);
+    result->key = NULL;
+    result->plaintext = NULL;
+    result->period = 0;
+}
+
+/**
+ * @brief Retrouve la clé d'un texte chiffré par Vigenère puis le déchiffre.
+ *
+ * Une fois la période connue, chaque colonne est un chiffrement de César : les
+ * 26 décalages de chaque colonne sont notés par khi-deux, les colonnes étant
+ * réparties entre plusieurs threads. La clé peut ensuite être affinée par
+ * indice de coïncidence mutuel entre colonnes.
+ *
+ * L'appelant est responsable de libérer le résultat avec free_vigenere_crack_result().
+ *
+ * @param ciphertext Le texte chiffré.
+ * @param period La longueur de clé, ou 0 pour l'estimer avec estimate_vigenere_key_length().
+ * @param refine 1 pour affiner la clé par IC mutuel, 0 sinon.
+ * @param result Reçoit la période, la clé et le texte déchiffré.
+ * @return 0 en cas de succès, -1 en cas d'erreur (texte trop court, allocation).
+ */
+int crack_vigenere(const char* ciphertext, size_t period, int refine, VigenereCrackResult* result) {
+    size_t len = strlen(ciphertext);
+    result->period = 0;
+    result->key = NULL;
+    result->plaintext = NULL;
+
+    if (period == 0) {
+        KeyLengthCandidate ranked[VIGENERE_MAX_PERIOD];
+        size_t count = estimate_vigenere_key_length(ciphertext, len, VIGENERE_MAX_PERIOD, ranked);
+        if (count == 0) {
+            fprintf(stderr, "Erreur: Texte trop court pour estimer la longueur de la clé.\n");
+            return -1;
+        }
+        // Les multiples de la vraie période ont un IC comparable : on retient le plus
+        // petit diviseur du meilleur candidat dont l'IC reste proche du sien.
+        period = ranked[0].period;
+        for (size_t r = 1; r < count; r++) {
+            if (ranked[r].period < period && ranked[0].period % ranked[r].period == 0
+                && ranked[r].ic >= 0.9 * ranked[0].ic) {
+                period = ranked[r].period;
+            }
         }
-        plaintext[i] = decrypted_char;
     }
-    plaintext[cipher_len] = '\0'; // Termine la chaîne avec un caractère nul
 
-    return plaintext;
+    // Une passe répartit les lettres du texte en colonnes contiguës
+    size_t stride = len / period + 1;
+    uint8_t* columns = (uint8_t*)malloc(period * stride);
+    size_t* counts = (size_t*)calloc(period * ALPHABET_SIZE, sizeof(size_t));
+    int* shifts = (int*)malloc(period * sizeof(int));
+    char* key = (char*)malloc(period + 1);
+    if (columns == NULL || counts == NULL || shifts == NULL || key == NULL) {
+        perror("Échec de l'allocation mémoire pour le cassage");
+        free(columns); free(counts); free(shifts); free(key);
+        return -1;
+    }
+    size_t n = deinterleave_letters(ciphertext, len, period, columns, stride);
+    if (n < 2 * period) {
+        // Période imposée trop longue pour le texte : au moins 2 lettres par colonne
+        fprintf(stderr, "Erreur: Texte trop court pour la longueur de clé demandée.\n");
+        free(columns); free(counts); free(shifts); free(key);
+        return -1;
+    }
+
+    // Khi-deux par colonne : les colonnes sont distribuées dynamiquement entre les threads
+    std::atomic<size_t> next_column(0);
+    auto worker = [&](unsigned) {
+        for (size_t c = next_column++; c < period; c = next_column++) {
+            size_t* column_counts = counts + c * ALPHABET_SIZE;
+            size_t total = coset_length(n, period, c);
+            column_histogram(columns + c * stride, total, column_counts);
+            shifts[c] = total > 0 ? best_column_shift(column_counts, total, FRENCH_FREQUENCIES) : 0;
+        }
+    };
+    unsigned thread_count = worker_count(period);
+    run_workers(thread_count, worker); // Le thread appelant participe aussi
+
+    if (refine && period > 1) {
+        refine_shifts_mutual_ic(counts, period, shifts);
+    }
+
+    for (size_t c = 0; c < period; c++) {
+        key[c] = (char)('A' + shifts[c]);
+    }
+    key[period] = '\0';
+    free(columns);
+    free(counts);
+    free(shifts);
+
+    char* plaintext = decrypt_vigenere(ciphertext, key);
+    if (plaintext == NULL) {
+        free(key);
+        return -1;
+    }
+    result->period = period;
+    result->key = key;
+    result->plaintext = plaintext;
+    return 0;
+}
+
+// --- Cryptanalyse des variantes ---
+
+/**
+ * @brief Remplace chaque lettre d'une clé par son opposé modulo 26 (clé majuscule).
+ */
+static void negate_key(char* key) {
+    for (char* c = key; *c != '\0'; c++) {
+        *c = (char)('A' + (ALPHABET_SIZE - (*c - 'A')) % ALPHABET_SIZE);
+    }
+}
+
+/**
+ * @brief Retrouve la clé d'un texte chiffré par Beaufort puis le déchiffre.
+ * L'opposé d'un chiffré de Beaufort, p - k, est un chiffré de Vigenère de clé
+ * -k : crack_vigenere() s'y applique directement.
+ * L'appelant est responsable de libérer le résultat avec free_vigenere_crack_result().
+ * @param ciphertext Le texte chiffré.
+ * @param period La longueur de clé, ou 0 pour l'estimer.
+ * @param refine 1 pour affiner la clé par IC mutuel, 0 sinon.
+ * @param result Reçoit la période, la clé de Beaufort et le texte déchiffré.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int crack_beaufort(const char* ciphertext, size_t period, int refine, VigenereCrackResult* result) {
+    size_t len = strlen(ciphertext);
+    char* negated = (char*)malloc((len + 1) * sizeof(char));
+    if (negated == NULL) {
+        perror("Échec de l'allocation mémoire pour l'analyse");
+        return -1;
+    }
+    memcpy(negated, ciphertext, len + 1);
+    negate_letters(negated, len);
+    int status = crack_vigenere(negated, period, refine, result);
+    free(negated);
+    if (status == 0) {
+        negate_key(result->key);
+    }
+    return status;
+}
+
+/**
+ * @brief Retrouve la clé d'un texte chiffré par Beaufort variante puis le déchiffre.
+ * Beaufort variante de clé k est un Vigenère de clé -k.
+ * L'appelant est responsable de libérer le résultat avec free_vigenere_crack_result().
+ * Mêmes paramètres que crack_beaufort().
+ */
+int crack_variant_beaufort(const char* ciphertext, size_t period, int refine, VigenereCrackResult* result) {
+    int status = crack_vigenere(ciphertext, period, refine, result);
+    if (status == 0) {
+        negate_key(result->key);
+    }
+    return status;
+}
+
+// Texte français de référence, utilisé pour construire le modèle de bigrammes
+// de l'attaque de l'autoclave. Un corpus plus long donne des statistiques plus fiables.
+static const char FRENCH_REFERENCE_TEXT[] =
+    "La cryptographie est une des disciplines de la cryptologie s'attachant a proteger des messages "
+    "en assurant leur confidentialite, leur authenticite et leur integrite, en s'aidant souvent de "
+    "secrets ou cles. Elle se distingue de la steganographie qui fait passer inapercu un message dans "
+    "un autre message alors que la cryptographie rend un message supposement inintelligible a autre "
+    "que qui de droit. Elle est utilisee depuis l'Antiquite, mais certaines de ses methodes les plus "
+    "importantes, comme la cryptographie asymetrique, datent de la fin du vingtieme siecle. Les "
+    "premiers documents chiffres connus remontent a l'Antiquite. Le plus ancien est une tablette "
+    "d'argile, trouvee en Irak, et datant du seizieme siecle avant notre ere. Un potier y avait grave "
+    "sa recette secrete en supprimant des consonnes et en modifiant l'orthographe des mots. Le "
+    "chiffrement de Vigenere est un systeme de chiffrement par substitution polyalphabetique dans "
+    "lequel une meme lettre du message clair peut, suivant sa position dans celui-ci, etre remplacee "
+    "par des lettres differentes, contrairement a un systeme de chiffrement monoalphabetique comme le "
+    "chiffre de Cesar. Cette methode resiste ainsi a l'analyse de frequences, ce qui est un avantage "
+    "decisif sur les chiffrements monoalphabetiques. Cependant le chiffre de Vigenere a ete perce par "
+    "le major prussien Friedrich Kasiski qui a publie sa methode en mil huit cent soixante trois. "
+    "Depuis cette epoque, il n'offre plus aucune securite. Il est nomme ainsi au dix-neuvieme siecle "
+    "en reference au diplomate du seizieme siecle Blaise de Vigenere, qui le decrit parmi d'autres "
+    "dans son traite des chiffres paru en mil cinq cent quatre-vingt-six.";
+
+/**
+ * @brief Construit la table des log-probabilités de bigrammes d'un corpus (lissage de Laplace).
+ * Les non-lettres sont ignorées : deux lettres séparées par une ponctuation forment un bigramme.
+ * @param corpus Le texte de référence.
+ * @param len Le nombre d'octets du corpus.
+ * @param logp Reçoit la log-probabilité de chaque couple de lettres consécutives.
+ */
+static void build_bigram_log_probabilities(const char* corpus, size_t len, double logp[ALPHABET_SIZE][ALPHABET_SIZE]) {
+    size_t counts[ALPHABET_SIZE][ALPHABET_SIZE] = {{0}};
+    size_t total = 0;
+    int previous = -1;
+    for (size_t i = 0; i < len; i++) {
+        unsigned letter = ((unsigned char)corpus[i] | 0x20) - 'a';
+        if (letter >= ALPHABET_SIZE) continue;
+        if (previous >= 0) {
+            counts[previous][letter]++;
+            total++;
+        }
+        previous = (int)letter;
+    }
+    for (int a = 0; a < ALPHABET_SIZE; a++) {
+        for (int b = 0; b < ALPHABET_SIZE; b++) {
+            logp[a][b] = log((counts[a][b] + 1.0) / (total + ALPHABET_SIZE * ALPHABET_SIZE));
+        }
+    }
+}
+
+/**
+ * @brief Déchiffre la chaîne j (positions j, j + m, j + 2m...) d'un chiffré autoclave.
+ * @param letters Les lettres chiffrées (indices 0-25).
+ * @param n Le nombre de lettres.
+ * @param j L'indice de la chaîne.
+ * @param m La longueur de l'amorce.
+ * @param primer La lettre j de l'amorce (0-25).
+ * @param plain Reçoit les lettres claires de la chaîne, aux mêmes positions.
+ */
+static void decrypt_autokey_chain(const uint8_t* letters, size_t n, size_t j, size_t m, int primer, uint8_t* plain) {
+    int key = primer;
+    for (size_t i = j; i < n; i += m) {
+        int p = letters[i] - key;
+        if (p < 0) p += ALPHABET_SIZE;
+        plain[i] = (uint8_t)p;
+        key = p;
+    }
+}
+
+/**
+ * @brief Log-vraisemblance des bigrammes qui touchent la chaîne j d'un clair.
+ * Pour m >= 2, deux lettres voisines appartiennent à des chaînes différentes :
+ * ce sont les bigrammes qui changent quand seule la lettre j de l'amorce change.
+ */
+static double autokey_chain_bigram_score(const uint8_t* plain, size_t n, size_t j, size_t m,
+                                         const double logp[ALPHABET_SIZE][ALPHABET_SIZE]) {
+    double score = 0.0;
+    for (size_t i = j; i < n; i += m) {
+        if (i > 0) score += logp[plain[i - 1]][plain[i]];
+        if (m > 1 && i + 1 < n) score += logp[plain[i]][plain[i + 1]];
+    }
+    return score;
+}
+
+/**
+ * @brief Retrouve l'amorce d'un texte chiffré par Vigenère autoclave puis le déchiffre.
+ *
+ * Avec une amorce de longueur m, la lettre claire i sert de clé à la lettre
+ * i + m : la suite des positions j, j + m, j + 2m... se déchiffre entièrement
+ * à partir de la seule lettre j de l'amorce. Un pré-filtre par fréquences de
+ * lettres (unigrammes) retient les AUTOKEY_CANDIDATES lettres les plus
+ * probables pour chaque chaîne ; l'amorce est ensuite choisie parmi elles en
+ * maximisant la log-vraisemblance des bigrammes du clair complet, lettre par
+ * lettre jusqu'à stabilité (deux chaînes voisines partagent leurs bigrammes).
+ * Les longueurs 1..max_primer sont réparties entre les threads ; la longueur
+ * retenue est celle dont le clair complet a la meilleure log-vraisemblance de
+ * bigrammes.
+ *
+ * L'appelant est responsable de libérer le résultat avec free_vigenere_crack_result().
+ *
+ * @param ciphertext Le texte chiffré.
+ * @param max_primer La plus grande longueur d'amorce envisagée (0 : VIGENERE_MAX_PERIOD).
+ * @param result Reçoit la longueur de l'amorce, l'amorce et le texte déchiffré.
+ * @return 0 en cas de succès, -1 en cas d'erreur (texte trop court, allocation).
+ */
+int crack_autokey(const char* ciphertext, size_t max_primer, VigenereCrackResult* result) {
+    result->period = 0;
+    result->key = NULL;
+    result->plaintext = NULL;
+    if (max_primer == 0) max_primer = VIGENERE_MAX_PERIOD;
+
+    size_t len = strlen(ciphertext);
+    uint8_t* letters = (uint8_t*)malloc(len > 0 ? len : 1);
+    if (letters == NULL) {
+        perror("Échec de l'allocation mémoire pour l'analyse");
+        return -1;
+    }
+    size_t n = extract_letters(ciphertext, len, letters);
+    if (max_primer > n / 2) max_primer = n / 2; // Au moins 2 lettres par chaîne
+    if (max_primer == 0) {
+        fprintf(stderr, "Erreur: Texte trop court pour retrouver l'amorce.\n");
+        free(letters);
+        return -1;
+    }
+
+    double log_frequencies[ALPHABET_SIZE];
+    for (int l = 0; l < ALPHABET_SIZE; l++) {
+        log_frequencies[l] = log(FRENCH_FREQUENCIES[l]);
+    }
+    double bigram_logp[ALPHABET_SIZE][ALPHABET_SIZE];
+    build_bigram_log_probabilities(FRENCH_REFERENCE_TEXT, strlen(FRENCH_REFERENCE_TEXT), bigram_logp);
+
+    unsigned thread_count = worker_count(max_primer);
+    // primers[m * max_primer + j] : lettre j de la meilleure amorce de longueur m
+    uint8_t* primers = (uint8_t*)malloc((max_primer + 1) * max_primer);
+    double* scores = (double*)malloc((max_primer + 1) * sizeof(double));
+    // Par thread : le clair courant (n lettres) et les lettres retenues par le pré-filtre
+    uint8_t* plains = (uint8_t*)malloc(thread_count * n);
+    uint8_t* shortlists = (uint8_t*)malloc(thread_count * max_primer * AUTOKEY_CANDIDATES);
+    if (primers == NULL || scores == NULL || plains == NULL || shortlists == NULL) {
+        perror("Échec de l'allocation mémoire pour l'analyse");
+        free(letters); free(primers); free(scores); free(plains); free(shortlists);
+        return -1;
+    }
+
+    std::atomic<size_t> next_length(1);
+    auto worker = [&](unsigned t) {
+        uint8_t* plain = plains + t * n;
+        uint8_t* shortlist = shortlists + t * max_primer * AUTOKEY_CANDIDATES;
+        for (size_t m = next_length++; m <= max_primer; m = next_length++) {
+            uint8_t* primer = primers + m * max_primer;
+            // Pré-filtre : les lettres d'amorce dont la chaîne a les meilleures fréquences
+            for (size_t j = 0; j < m; j++) {
+                double best[AUTOKEY_CANDIDATES];
+                uint8_t* candidates = shortlist + j * AUTOKEY_CANDIDATES;
+                for (int c = 0; c < AUTOKEY_CANDIDATES; c++) best[c] = -INFINITY;
+                for (int s = 0; s < ALPHABET_SIZE; s++) {
+                    double score = 0.0;
+                    int key = s;
+                    for (size_t i = j; i < n; i += m) {
+                        int p = letters[i] - key;
+                        if (p < 0) p += ALPHABET_SIZE;
+                        score += log_frequencies[p];
+                        key = p;
+                    }
+                    int pos = AUTOKEY_CANDIDATES;
+                    while (pos > 0 && best[pos - 1] < score) {
+                        if (pos < AUTOKEY_CANDIDATES) {
+                            best[pos] = best[pos - 1];
+                            candidates[pos] = candidates[pos - 1];
+                        }
+                        pos--;
+                    }
+                    if (pos < AUTOKEY_CANDIDATES) {
+                        best[pos] = score;
+                        candidates[pos] = (uint8_t)s;
+                    }
+                }
+                primer[j] = candidates[0];
+                decrypt_autokey_chain(letters, n, j, m, primer[j], plain);
+            }
+            // Choix par bigrammes, une lettre d'amorce à la fois, jusqu'à stabilité
+            for (int changed = 1; changed;) {
+                changed = 0;
+                for (size_t j = 0; j < m; j++) {
+                    const uint8_t* candidates = shortlist + j * AUTOKEY_CANDIDATES;
+                    int best_letter = primer[j];
+                    double best_score = autokey_chain_bigram_score(plain, n, j, m, bigram_logp);
+                    for (int c = 0; c < AUTOKEY_CANDIDATES; c++) {
+                        if (candidates[c] == primer[j]) continue;
+                        decrypt_autokey_chain(letters, n, j, m, candidates[c], plain);
+                        double score = autokey_chain_bigram_score(plain, n, j, m, bigram_logp);
+                        if (score > best_score) {
+                            best_score = score;
+                            best_letter = candidates[c];
+                        }
+                    }
+                    if (best_letter != primer[j]) changed = 1;
+                    primer[j] = (uint8_t)best_letter;
+                    decrypt_autokey_chain(letters, n, j, m, best_letter, plain);
+                }
+            }
+            double total = 0.0;
+            for (size_t i = 1; i < n; i++) total += bigram_logp[plain[i - 1]][plain[i]];
+            scores[m] = total;
+        }
+    };
+    run_workers(thread_count, worker); // Le thread appelant participe aussi
+    free(plains);
+    free(shortlists);
+
+    size_t period = 1;
+    for (size_t m = 2; m <= max_primer; m++) {
+        if (scores[m] > scores[period]) period = m;
+    }
+    char* key = (char*)malloc(period + 1);
+    if (key == NULL) {
+        perror("Échec de l'allocation mémoire pour la clé");
+        free(letters); free(primers); free(scores);
+        return -1;
+    }
+    for (size_t j = 0; j < period; j++) {
+        key[j] = (char)('A' + primers[period * max_primer + j]);
+    }
+    key[period] = '\0';
+    free(letters);
+    free(primers);
+    free(scores);
+
+    VigenereKey compiled_key;
+    char* plaintext = NULL;
+    if (compile_vigenere_key(key, &compiled_key) == 0) {
+        plaintext = decrypt_autokey(ciphertext, &compiled_key);
+        free_vigenere_key(&compiled_key);
+    }
+    if (plaintext == NULL) {
+        free(key);
+        return -1;
+    }
+    result->period = period;
+    result->key = key;
+    result->plaintext = plaintext;
+    return 0;
 }
 
 /**
@@ -165,20 +1971,137 @@ int main() {
     printf("Message original : \"%s\"\n", message);
     printf("Clé utilisée : \"%s\"\n", key);
 
+    // --- Compilation de la clé (une seule fois pour le chiffrement et le déchiffrement) ---
+    VigenereKey compiled_key;
+    if (compile_vigenere_key(key, &compiled_key) == -1) {
+        fprintf(stderr, "Le chiffrement a échoué. Vérifiez la clé.\n");
+        return 1;
+    }
+
     // --- Chiffrement ---
-    char* encrypted_text = encrypt_vigenere(message, key);
-    if (encrypted_text != NULL) { // Vérifie si le chiffrement a réussi (pas d'erreur d'allocation/clé vide)
+    char* encrypted_text = encrypt_vigenere(message, &compiled_key);
+    if (encrypted_text != NULL) { // Vérifie si le chiffrement a réussi (pas d'erreur d'allocation)
         printf("Message chiffré : \"%s\"\n", encrypted_text);
 
         // --- Déchiffrement ---
-        char* decrypted_text = decrypt_vigenere(encrypted_text, key);
+        char* decrypted_text = decrypt_vigenere(encrypted_text, &compiled_key);
         if (decrypted_text != NULL) { // Vérifie si le déchiffrement a réussi
             printf("Message déchiffré : \"%s\"\n", decrypted_text);
             free(decrypted_text); // Libère la mémoire allouée pour le texte déchiffré
         }
         free(encrypted_text); // Libère la mémoire allouée pour le texte chiffré
     } else {
-        fprintf(stderr, "Le chiffrement a échoué. Vérifiez la clé.\n");
+        fprintf(stderr, "Le chiffrement a échoué.\n");
+    }
+
+    // --- Variantes avec la même clé compilée ---
+    printf("\n--- Variantes ---\n");
+    char* beaufort_text = encrypt_beaufort(message, &compiled_key);
+    if (beaufort_text != NULL) {
+        printf("Beaufort : \"%s\"\n", beaufort_text);
+        free(beaufort_text);
+    }
+    char* variant_text = encrypt_variant_beaufort(message, &compiled_key);
+    if (variant_text != NULL) {
+        printf("Beaufort variante : \"%s\"\n", variant_text);
+        free(variant_text);
+    }
+    char* autokey_text = encrypt_autokey(message, &compiled_key);
+    if (autokey_text != NULL) {
+        printf("Autoclave : \"%s\"\n", autokey_text);
+        char* autokey_plain = decrypt_autokey(autokey_text, &compiled_key);
+        if (autokey_plain != NULL) {
+            printf("Autoclave déchiffré : \"%s\"\n", autokey_plain);
+            free(autokey_plain);
+        }
+        free(autokey_text);
+    }
+    free_vigenere_key(&compiled_key);
+
+    // --- Traitement par lots : chaque message de l'arène a sa propre clé ---
+    char batch_arena[] = "ATTAQUEALAUBE" "RENDEZVOUS" "AUPONT";
+    const char batch_keys[] = "LEMON" "CLE" "SECRET";
+    VigenereRecord batch_records[] = {{0, 13, 0, 5}, {13, 10, 5, 3}, {23, 6, 8, 6}};
+    size_t batch_count = sizeof(batch_records) / sizeof(batch_records[0]);
+    if (encrypt_vigenere_batch(batch_arena, batch_arena, batch_keys, batch_records, batch_count, 0) == 0) {
+        printf("\nLot chiffré : \"%s\"\n", batch_arena);
+        if (encrypt_vigenere_batch(batch_arena, batch_arena, batch_keys, batch_records, batch_count, 1) == 0) {
+            printf("Lot déchiffré : \"%s\"\n", batch_arena);
+        }
+    }
+
+    // --- Cryptanalyse d'un paragraphe français chiffré avec des clés connues ---
+    // Texte absent du texte de référence qui sert de modèle de bigrammes
+    const char* french_paragraph =
+        "Pendant la seconde guerre mondiale, les armees allemandes utilisaient une machine "
+        "electromecanique appelee Enigma pour chiffrer leurs communications. Chaque message passait "
+        "par une serie de rotors dont la position changeait a chaque lettre, ce qui rendait l'analyse "
+        "des frequences inutile. Des mathematiciens polonais reussirent pourtant a reconstituer le "
+        "cablage des rotors avant la guerre, puis transmirent leurs travaux aux services britanniques. "
+        "A Bletchley Park, une equipe reunie autour d'Alan Turing construisit des machines capables de "
+        "tester rapidement les reglages possibles en s'appuyant sur des mots probables, comme les "
+        "bulletins meteorologiques envoyes chaque matin.";
+    VigenereCrackResult crack_result;
+
+    printf("\n--- Cryptanalyse de Vigenère (clé \"CHIFFREMENT\") ---\n");
+    VigenereKey secret_key;
+    if (compile_vigenere_key("CHIFFREMENT", &secret_key) == 0) {
+        char* secret_text = encrypt_vigenere(french_paragraph, &secret_key);
+        if (secret_text != NULL) {
+            size_t secret_len = strlen(secret_text);
+            KeyLengthCandidate ranked[VIGENERE_MAX_PERIOD];
+            size_t ranked_count = estimate_vigenere_key_length(secret_text, secret_len, VIGENERE_MAX_PERIOD, ranked);
+            for (size_t i = 0; i < ranked_count && i < 3; i++) {
+                printf("Période %2zu : IC = %.4f, Kasiski = %.2f, score = %.2f\n",
+                       ranked[i].period, ranked[i].ic, ranked[i].kasiski, ranked[i].score);
+            }
+            size_t autocorrelation_period = detect_period_autocorrelation(secret_text, secret_len, VIGENERE_MAX_PERIOD);
+            printf("Période par autocorrélation : %zu\n", autocorrelation_period);
+            double rates[VIGENERE_MAX_PERIOD + 1];
+            if (autocorrelation_period > 0 && coincidence_autocorrelation(secret_text, secret_len, VIGENERE_MAX_PERIOD, rates) > 0) {
+                printf("Taux de coïncidence : décalage 1 = %.4f, décalage %zu = %.4f\n",
+                       rates[1], autocorrelation_period, rates[autocorrelation_period]);
+            }
+            if (crack_vigenere(secret_text, 0, 1, &crack_result) == 0) {
+                printf("Clé Vigenère retrouvée : %s\n", crack_result.key);
+                printf("Début du clair : \"%.60s\"\n", crack_result.plaintext);
+                free_vigenere_crack_result(&crack_result);
+            }
+            free(secret_text);
+        }
+
+        char* beaufort_secret = encrypt_beaufort(french_paragraph, &secret_key);
+        if (beaufort_secret != NULL) {
+            if (crack_beaufort(beaufort_secret, 0, 1, &crack_result) == 0) {
+                printf("Clé Beaufort retrouvée : %s\n", crack_result.key);
+                free_vigenere_crack_result(&crack_result);
+            }
+            free(beaufort_secret);
+        }
+        char* variant_secret = encrypt_variant_beaufort(french_paragraph, &secret_key);
+        if (variant_secret != NULL) {
+            if (crack_variant_beaufort(variant_secret, 0, 1, &crack_result) == 0) {
+                printf("Clé Beaufort variante retrouvée : %s\n", crack_result.key);
+                free_vigenere_crack_result(&crack_result);
+            }
+            free(variant_secret);
+        }
+        free_vigenere_key(&secret_key);
+    }
+
+    printf("\n--- Cryptanalyse de l'autoclave (amorce \"ENIGMA\") ---\n");
+    VigenereKey secret_primer;
+    if (compile_vigenere_key("ENIGMA", &secret_primer) == 0) {
+        char* autokey_secret = encrypt_autokey(french_paragraph, &secret_primer);
+        if (autokey_secret != NULL) {
+            if (crack_autokey(autokey_secret, 0, &crack_result) == 0) {
+                printf("Amorce retrouvée : %s\n", crack_result.key);
+                printf("Clair correct : %s\n", strcmp(crack_result.plaintext, french_paragraph) == 0 ? "oui" : "non");
+                free_vigenere_crack_result(&crack_result);
+            }
+            free(autokey_secret);
+        }
+        free_vigenere_key(&secret_primer);
     }
 
     return 0; // Termine le programme avec succès